@@ -2,10 +2,16 @@
 #include "cook/process/chef/CompileArchiveLink.hpp"
 #include "cook/algo/Book.hpp"
 #include "cook/util/File.hpp"
+#include "cook/util/Parallel.hpp"
 #include "cook/log/Scope.hpp"
 #include "cook/generator/Interface.hpp"
+#include "cook/process/module/Collator.hpp"
 #include "gubg/mss.hpp"
+#include "gubg/hash/MD5.hpp"
 #include <unordered_set>
+#include <algorithm>
+#include <vector>
+#include <set>
 
 namespace  { 
 /* const char *logns = "App"; */
@@ -45,6 +51,16 @@ Result App::process_()
 
     options_.stream();
 
+    // the collation of the scanned modules is called from the build itself, no recipes are needed
+    if (!options_.collate_modules.empty())
+    {
+        MSS(collate_modules_());
+        MSS_RETURN_OK();
+    }
+
+    kitchen_.set_executable(options_.executable);
+    kitchen_.set_invocation(options_.arguments, std::filesystem::current_path());
+
     // set the directories
     kitchen_.dirs().set_output(options_.output_path);
     kitchen_.dirs().set_temporary(options_.temp_path);
@@ -121,7 +137,15 @@ Result App::process_()
     }
     
     // dependening the chef, we will respond differently
-    if (chef)
+    if (chef && !options_.configurations.empty())
+    {
+        MSS(process_configurations_(*chef, resolve_result));
+        kitchen_.menu().stream();
+
+        // ouput if there were unresolved dependencies
+        MSS(resolve_result);
+    }
+    else if (chef)
     {
         if (resolve_result)
         {
@@ -148,6 +172,62 @@ Result App::process_()
     MSS_END();
 }
 
+Result App::process_configurations_(process::chef::Interface & chef, const Result & resolve_result)
+{
+    MSS_BEGIN(Result);
+
+    if (resolve_result)
+        MSS(chef.initialize());
+
+    // every configuration starts from the recipes as they are loaded, the loading, globbing and dependency graph are shared
+    std::list<std::pair<model::Recipe *, model::Recipe::Snapshot>> snapshots;
+    for (model::Recipe * recipe: kitchen_.menu().topological_order_recipes())
+        snapshots.emplace_back(recipe, recipe->snapshot());
+
+    auto is_set = [&](const std::string & key, const app::Options::Configuration & configuration)
+    {
+        auto has_key = [&](const app::Options::KeyValue & kv) { return kv.first == key; };
+        return std::any_of(RANGE(options_.toolchain_options), has_key) || std::any_of(RANGE(configuration.toolchain_options), has_key);
+    };
+
+    bool is_first = true;
+    for (const auto & configuration: options_.configurations)
+    {
+        auto ss = log::scope("Processing configuration", -2, [&](auto &n){n.attr("name", configuration.name);});
+
+        kitchen_.dirs().set_output(std::filesystem::path(options_.output_path) / configuration.name);
+        kitchen_.dirs().set_temporary(std::filesystem::path(options_.temp_path) / configuration.name);
+
+        process::toolchain::Manager::Overrides overrides;
+        for (const auto & kv: configuration.toolchain_options)
+            overrides[kv.first] = (!!kv.second ? *kv.second : std::string("true"));
+        MSS(kitchen_.toolchain().set_configuration(overrides));
+
+        // the profiles and the ThinLTO cache belong to the configuration, which can also be the one that enables pgo or lto
+        const auto defaults = kitchen_.optimization_defaults([&](const std::string & key) { return is_set(key, configuration); });
+        if (!defaults.empty())
+        {
+            overrides.insert(RANGE(defaults));
+            MSS(kitchen_.toolchain().set_configuration(overrides));
+        }
+
+        if (!is_first)
+        {
+            for (const auto & p: snapshots)
+                p.first->restore(p.second);
+            kitchen_.menu().reset_build_graphs();
+        }
+        is_first = false;
+
+        if (resolve_result)
+            MSS(chef.mis_en_place(kitchen_));
+
+        MSS(process_generators_());
+    }
+
+    MSS_END();
+}
+
 Result App::process_generator_(const std::string & name, const std::optional<std::string> & value) const
 {
     MSS_BEGIN(Result);
@@ -173,9 +253,49 @@ Result App::process_generators_() const
 {
     MSS_BEGIN(Result);
 
+    // the generators that change the context run one by one, the read-only generators run concurrently afterwards
+    std::vector<Result> results(options_.generators.size());
+    std::vector<std::size_t> read_only;
+    {
+        std::set<Context::GeneratorPtr> scheduled;
+        std::size_t ix = 0;
+        for(const auto & p: options_.generators)
+        {
+            Context::GeneratorPtr ptr = kitchen_.get_generator(p.first);
+            // a generator that is requested more than once cannot run concurrently with itself
+            if (ptr && ptr->is_read_only() && scheduled.insert(ptr).second)
+                read_only.push_back(ix);
+            else
+                results[ix] = process_generator_(p.first, p.second);
+            ++ix;
+        }
+    }
+
+    if (!read_only.empty())
+    {
+        std::vector<const app::Options::KeyValue *> generators;
+        for (const auto & p: options_.generators)
+            generators.push_back(&p);
+
+        util::parallel_for(read_only.size(), [&](std::size_t ix)
+        {
+            const auto & p = *generators[read_only[ix]];
+            Result & result = results[read_only[ix]];
+            try
+            {
+                result = process_generator_(p.first, p.second);
+            }
+            catch (const std::exception & exc)
+            {
+                result << Message(Message::Type::InternalError, std::string("Unexpected exception in generator ") + p.first + ": " + exc.what());
+            }
+        });
+    }
+
+    // merge in the order of the generators, independent of the order of execution
     Result rc;
-    for(const auto & p: options_.generators)
-        rc.merge(process_generator_(p.first, p.second));
+    for (const auto & result: results)
+        rc.merge(result);
 
     MSS(rc);
 
@@ -202,12 +322,78 @@ Result App::load_recipes_()
     if (options_.recipe_files.empty())
         options_.recipe_files.push_back("./");
 
+    // only the closure of the requested recipes is needed: the manifest of a previous full load tells which scripts can be skipped
+    const bool use_manifest = !options_.recipes.empty();
+    const auto manifest_fn = kitchen_.dirs().temporary(true) / "recipes.manifest";
+    const auto key = manifest_key_();
+
+    chai::Manifest manifest;
+    if (use_manifest && manifest.read(manifest_fn) && manifest.is_up_to_date(key))
+    {
+        std::list<std::string> roots;
+        for (const auto & rcp: options_.recipes)
+            roots.push_back(model::Uri(rcp).as_absolute().string());
+
+        std::set<std::filesystem::path> skippable;
+        if (manifest.skippable_scripts(skippable, roots))
+        {
+            MSS_RC << MESSAGE(Info, "Skipping " << skippable.size() << " of " << manifest.scripts().size() << " scripts based on " << manifest_fn.string());
+            kitchen_.set_skippable_scripts(skippable, manifest);
+
+            for(const auto & fn : options_.recipe_files)
+                MSS(kitchen_.load_recipe(fn));
+
+            MSS_RETURN_OK();
+        }
+    }
+
+    // a full load, recording the manifest for the next run
+    manifest.clear();
+    manifest.set_key(key);
+    kitchen_.set_manifest(&manifest);
+    Result rc;
     for(const auto & fn : options_.recipe_files)
-        MSS(kitchen_.load_recipe(fn));
+        rc.merge(kitchen_.load_recipe(fn));
+    kitchen_.set_manifest(nullptr);
+    MSS(rc);
+
+    for (model::Recipe * recipe: kitchen_.lib().list_all_recipes())
+    {
+        for (const auto & p: recipe->dependency_pairs())
+        {
+            model::Recipe * dep = p.second.recipe;
+            if (!dep)
+                MSS(kitchen_.lib().find_dependency(dep, *recipe, p.first));
+            if (dep)
+                manifest.add_dependency(recipe->uri().string(), dep->uri().string());
+        }
+    }
+    MSS(manifest.write(manifest_fn));
 
     MSS_END();
 }
 
+std::string App::manifest_key_() const
+{
+    // everything that influences the evaluation of the recipe scripts, besides the scripts themselves
+    gubg::hash::md5::Stream s;
+    auto add_key_values = [&](const char * name, const std::list<app::Options::KeyValue> & kvs)
+    {
+        for (const auto & kv: kvs)
+            s << name << '\t' << kv.first << '\t' << (!!kv.second ? "=" + *kv.second : std::string()) << '\n';
+    };
+    for (const auto & fn: options_.recipe_files)
+        s << "recipe_file\t" << fn << '\n';
+    for (const auto & dir: options_.include_dirs)
+        s << "include_dir\t" << dir << '\n';
+    for (const auto & tc: options_.toolchains)
+        s << "toolchain\t" << tc << '\n';
+    add_key_values("toolchain_option", options_.toolchain_options);
+    add_key_values("variable", options_.variables);
+    s << "cwd\t" << std::filesystem::current_path().string() << '\n';
+    return s.hash_hex();
+}
+
 Result App::extract_root_recipes_(std::list<model::Recipe*> & result) const
 {
     MSS_BEGIN(Result);
@@ -236,6 +422,37 @@ Result App::extract_root_recipes_(std::list<model::Recipe*> & result) const
     MSS_END();
 }
 
+Result App::collate_modules_() const
+{
+    MSS_BEGIN(Result);
+
+    auto ss = log::scope("collate modules", -2, [&](auto &n){n.attr("format", options_.collate_modules).attr("dyndep", options_.dyndep);});
+
+    process::module::Format format;
+    MSG_MSS(process::module::parse(format, options_.collate_modules), Error, "unknown module format '" << options_.collate_modules << "'");
+    MSG_MSS(!options_.dyndep.empty(), Error, "no dyndep file specified for the module collation");
+
+    process::module::Collator collator(format, options_.bmi_dir);
+
+    // the remaining arguments are the module information files of the recipe itself
+    for (const auto & fn: options_.recipes)
+    {
+        process::module::P1689 info;
+        MSS(process::module::read(info, fn));
+        MSS(collator.add_own(fn, info));
+    }
+    for (const auto & fn: options_.module_infos)
+    {
+        process::module::P1689 info;
+        MSS(process::module::read(info, fn));
+        MSS(collator.add_dependency(info));
+    }
+
+    MSS(collator.write(options_.dyndep));
+
+    MSS_END();
+}
+
 void App::write_(const Result & result)
 {
     result.each_message([&](const Message & msg) {
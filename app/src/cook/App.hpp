@@ -3,6 +3,7 @@
 
 #include "cook/app/Options.hpp"
 #include "cook/chai/Context.hpp"
+#include "cook/process/chef/Interface.hpp"
 #include "gubg/naft/Document.hpp"
 
 namespace cook {
@@ -18,9 +19,13 @@ private:
 
     Result extract_root_recipes_(std::list<model::Recipe *> & result) const;
     Result load_recipes_();
+    std::string manifest_key_() const;
     Result load_toolchains_();
     Result process_generators_() const;
+    //Forks the shared recipes and menu per named configuration, at the chef and the generators
+    Result process_configurations_(process::chef::Interface & chef, const Result & resolve_result);
     Result process_generator_(const std::string & name, const std::optional<std::string> & value) const;
+    Result collate_modules_() const;
 
     void write_(const Result & result);
 
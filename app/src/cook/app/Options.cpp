@@ -2,7 +2,10 @@
 #include "cook/Version.hpp"
 #include "gubg/mss.hpp"
 #include "gubg/OptionParser.hpp"
+#include "gubg/std/filesystem.hpp"
 #include <algorithm>
+#include <sstream>
+#include <set>
 
 namespace cook { namespace app {
 
@@ -22,6 +25,25 @@ Options::KeyValue parse_key_value_pair(const std::string & str)
     return kv;
 }
 
+// "name:key=value,key" or just "name"
+Options::Configuration parse_configuration(const std::string & str)
+{
+    Options::Configuration configuration;
+
+    const std::size_t pos = str.find(':');
+    configuration.name = str.substr(0, pos);
+
+    if (pos != std::string::npos)
+    {
+        std::istringstream iss(str.substr(pos+1));
+        for (std::string option; std::getline(iss, option, ',');)
+            if (!option.empty())
+                configuration.toolchain_options.push_back(parse_key_value_pair(option));
+    }
+
+    return configuration;
+}
+
 }
 
 bool Options::parse(int argc, const char ** argv)
@@ -37,6 +59,7 @@ bool Options::parse(int argc, const char ** argv)
         opt.add_mandatory(  'O', "--temp-dir             ", "Temporary build cache directory. Default is .cook", [&](const std::string & str) {temp_path = str; });
         opt.add_mandatory(  't', "--toolchain-file       ", "The toolchain-file to use. If not found and any of [gcc,clang, msvc, default] a toolchain is generated in the working directory", [&](const std::string & str) { toolchains.push_back(str); });
         opt.add_mandatory(  'T', "--toolchain-option     ", "Passes the option to the toolchain.", [&](const std::string & str) { toolchain_options.push_back(parse_key_value_pair(str)); });
+        opt.add_mandatory(  'K', "--configuration        ", "A named configuration as <name>[:<option>,<option>], with toolchain options on top of the global ones. Each configuration is generated in its own subdirectory of the output and temporary directory, the recipes are loaded only once.", [&](const std::string & str) { configurations.push_back(parse_configuration(str)); });
         opt.add_mandatory(  'I', "--include-dir           ", "Use the specified directory as include directory", [&](const std::string & str) { include_dirs.push_back(str); });
         opt.add_mandatory(  'g', "--generator            ", "A generator to use [naft|ninja|cmake|build]. If none are specified, then build is used.", [&](const std::string & str) { generators.push_back(parse_key_value_pair(str)); });
         opt.add_mandatory(  'C', "--chef                 ", "Chef to use [scal|cal|void]", [&](const std::string &str){ chef = str; });
@@ -44,6 +67,10 @@ bool Options::parse(int argc, const char ** argv)
         opt.add_mandatory(  'D', "--data                 ", "Passes the chaiscript variables to the process.", [&](const std::string & str) { variables.push_back(parse_key_value_pair(str)); });
         opt.add_switch(     'h', "--help                 ", "Prints this help.", [&](){ print_help = true; });
         opt.add_mandatory(  'v', "--verbosity            ", "Verbosity level, 0 is silent. By default this is 1. ", [&](const std::string & str) { verbosity = std::max(0, std::stoi(str)); });
+        opt.add_mandatory(  'M', "--collate-modules      ", "Collate the module information files [gcc|clang], used by the generated build", [&](const std::string & str) { collate_modules = str; });
+        opt.add_mandatory(  'Y', "--dyndep               ", "The ninja dyndep file written by --collate-modules", [&](const std::string & str) { dyndep = str; });
+        opt.add_mandatory(  'B', "--bmi-dir              ", "The directory with the compiled module interfaces for --collate-modules", [&](const std::string & str) { bmi_dir = str; });
+        opt.add_mandatory(  'm', "--module-info          ", "Module information file of a dependency for --collate-modules", [&](const std::string & str) { module_infos.push_back(str); });
         opt.add_response (  '@', "--response             ", "Add the arguments from a response file.");
     }
 
@@ -55,10 +82,23 @@ bool Options::parse(int argc, const char ** argv)
         help_message = str.str();
     }
 
+    // the generated build can call back into this executable
+    if (argc > 0)
+    {
+        const std::filesystem::path exe = argv[0];
+        executable = (exe.has_parent_path() ? std::filesystem::absolute(exe).string() : exe.string());
+        arguments.assign(argv + 1, argv + argc);
+    }
+
     // parse the arguments
     auto args = gubg::OptionParser::create_args(argc, argv);
     MSS(opt.parse(args));
 
+    // each configuration gets its own subdirectory
+    std::set<std::string> configuration_names;
+    for (const auto & configuration: configurations)
+        MSS(!configuration.name.empty() && configuration_names.insert(configuration.name).second);
+
     // remaining elements are recipe names
     recipes.assign(args.begin(), args.end());
 
@@ -112,6 +152,8 @@ void Options::stream(log::Importance importance) const
     log_pair_range("toolchain-options", toolchain_options);
     log_pair_range("generators", generators);
     log_pair_range("variables", variables);
+    for (const auto & configuration: configurations)
+        log_pair_range("configuration." + configuration.name, configuration.toolchain_options);
 }
 
 } }
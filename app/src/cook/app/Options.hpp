@@ -12,10 +12,18 @@ namespace cook { namespace app {
     {
         using KeyValue = std::pair<std::string, std::optional<std::string>>;
 
+        //A named build configuration: its toolchain options are added to the global ones
+        struct Configuration
+        {
+            std::string name;
+            std::list<KeyValue> toolchain_options;
+        };
+
         std::list<std::string> recipe_files;
         std::list<std::string> toolchains;
         std::list<std::string> include_dirs;
         std::list<KeyValue> toolchain_options;
+        std::list<Configuration> configurations;
         std::string output_path = "./";
         std::string temp_path = ".cook";
         std::string chef;
@@ -28,6 +36,16 @@ namespace cook { namespace app {
 
         std::list<std::string> recipes;
 
+        //Collation mode, invoked from the generated build to process the scanned C++ modules
+        std::string collate_modules;
+        std::string dyndep;
+        std::string bmi_dir;
+        std::list<std::string> module_infos;
+
+        std::string executable;
+        //All arguments, to rerun cook from the generated build
+        std::list<std::string> arguments;
+
         std::string help_message;
 
         bool parse(int argc, const char **argv);
@@ -26,7 +26,9 @@ int main(int argc, const char ** argv)
         }
     }
 
-    App app;
+    // the app holds the model, the build graph and the script engine: it is not destroyed on purpose,
+    // the operating system releases its memory at once while a teardown visits every object
+    App & app = *new App;
     MSS(app.initialize(options), std::cerr << "Error initializing application" << std::endl);
     MSS(app.process());
 
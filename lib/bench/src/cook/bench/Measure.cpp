@@ -0,0 +1,82 @@
+#include "cook/bench/Measure.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+    std::atomic<std::size_t> allocation_count(0);
+
+}
+
+void * operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (void * ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace cook { namespace bench {
+
+    std::size_t nr_allocations()
+    {
+        return allocation_count.load();
+    }
+
+    std::size_t peak_rss_kb()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+        return counters.PeakWorkingSetSize/1024;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        //In bytes on macOS
+        return usage.ru_maxrss/1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    Measurement::Measurement()
+        : start_(std::chrono::steady_clock::now()),
+          allocations_(nr_allocations())
+    {
+    }
+
+    double Measurement::seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    std::size_t Measurement::allocations() const
+    {
+        return nr_allocations() - allocations_;
+    }
+
+    void stream_sample(std::ostream & os, const std::string & phase, double seconds, std::optional<std::size_t> allocations)
+    {
+        os << "{\"phase\": \"" << phase << "\", \"seconds\": " << seconds;
+        if (allocations)
+            os << ", \"allocations\": " << *allocations;
+        os << ", \"peak_rss_kb\": " << peak_rss_kb() << "}" << std::endl;
+    }
+
+} }
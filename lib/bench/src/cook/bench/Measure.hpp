@@ -0,0 +1,36 @@
+#ifndef HEADER_cook_bench_Measure_hpp_ALREADY_INCLUDED
+#define HEADER_cook_bench_Measure_hpp_ALREADY_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace cook { namespace bench {
+
+    //Counted by the global operator new of the benchmark executable
+    std::size_t nr_allocations();
+    //Peak resident set size of the process, 0 when unknown
+    std::size_t peak_rss_kb();
+
+    //Time and allocations since construction
+    class Measurement
+    {
+    public:
+        Measurement();
+
+        double seconds() const;
+        std::size_t allocations() const;
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+        std::size_t allocations_;
+    };
+
+    //One json object per line
+    void stream_sample(std::ostream & os, const std::string & phase, double seconds, std::optional<std::size_t> allocations = std::nullopt);
+
+} }
+
+#endif
@@ -0,0 +1,102 @@
+#include "cook/bench/Tree.hpp"
+#include "cook/util/File.hpp"
+#include "gubg/mss.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <sstream>
+
+namespace cook { namespace bench {
+
+    namespace {
+
+        std::string recipe_name(unsigned int book, unsigned int recipe)
+        {
+            return "b" + std::to_string(book) + "_r" + std::to_string(recipe);
+        }
+
+        std::filesystem::path source_dir(unsigned int ix, unsigned int depth)
+        {
+            std::filesystem::path dir;
+            for (unsigned int d = 0; d < depth; ++d)
+                dir /= "d" + std::to_string((ix >> d) & 1u);
+            return dir;
+        }
+
+    }
+
+    Result TreeConfig::set(const std::string & key, const std::string & value)
+    {
+        MSS_BEGIN(Result);
+
+        unsigned int * ptr = nullptr;
+        if (false) {}
+        else if (key == "books") ptr = &books;
+        else if (key == "recipes") ptr = &recipes;
+        else if (key == "sources") ptr = &sources;
+        else if (key == "headers") ptr = &headers;
+        else if (key == "fanout") ptr = &fanout;
+        else if (key == "depth") ptr = &depth;
+        MSG_MSS(!!ptr, Error, "Unknown tree parameter '" << key << "'");
+
+        std::istringstream iss(value);
+        MSG_MSS(!!(iss >> *ptr), Error, "Invalid value '" << value << "' for tree parameter '" << key << "'");
+
+        MSS_END();
+    }
+
+    void TreeConfig::stream(std::ostream & os) const
+    {
+        os << "{\"books\": " << books << ", \"recipes\": " << recipes << ", \"sources\": " << sources << ", \"headers\": " << headers << ", \"fanout\": " << fanout << ", \"depth\": " << depth << "}";
+    }
+
+    Result generate(const TreeConfig & config, const std::filesystem::path & dir)
+    {
+        MSS_BEGIN(Result);
+
+        std::ostringstream root;
+        for (unsigned int b = 0; b < config.books; ++b)
+        {
+            const std::string book = "b" + std::to_string(b);
+            root << "include(\"" << book << "\")" << std::endl;
+
+            std::ostringstream script;
+            for (unsigned int r = 0; r < config.recipes; ++r)
+            {
+                const std::string name = recipe_name(b, r);
+                const std::filesystem::path recipe_dir = dir / book / name;
+
+                script << "cook[\"" << book << "\"].recipe(\"" << name << "\", fun(r){" << std::endl;
+                script << "    r.add(\"${cook.script_local_directory()}/" << name << "\", \"**.[hc]pp\")" << std::endl;
+
+                //Deterministic pseudo-random dependencies on earlier recipes, which keeps the tree acyclic
+                const unsigned int index = b*config.recipes + r;
+                std::set<unsigned int> deps;
+                for (std::uint64_t state = index; deps.size() < std::min(config.fanout, index); )
+                {
+                    state = state*6364136223846793005ull + 1442695040888963407ull;
+                    deps.insert(static_cast<unsigned int>((state >> 33) % index));
+                }
+                for (auto dep: deps)
+                    script << "    r.depends_on(\"/b" << dep/config.recipes << "/" << recipe_name(dep/config.recipes, dep%config.recipes) << "\")" << std::endl;
+                script << "})" << std::endl;
+
+                for (unsigned int s = 0; s < config.sources; ++s)
+                {
+                    const std::string fn = name + "_s" + std::to_string(s);
+                    MSS(util::write_if_changed(recipe_dir / source_dir(s, config.depth) / (fn + ".cpp"), "int " + fn + "() { return " + std::to_string(s) + "; }\n"));
+                }
+                for (unsigned int h = 0; h < config.headers; ++h)
+                {
+                    const std::string fn = name + "_h" + std::to_string(h);
+                    MSS(util::write_if_changed(recipe_dir / source_dir(h, config.depth) / (fn + ".hpp"), "int " + fn + "();\n"));
+                }
+            }
+            MSS(util::write_if_changed(dir / book / "recipes.chai", script.str()));
+        }
+        MSS(util::write_if_changed(dir / "recipes.chai", root.str()));
+
+        MSS_END();
+    }
+
+} }
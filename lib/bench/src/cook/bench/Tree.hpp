@@ -0,0 +1,32 @@
+#ifndef HEADER_cook_bench_Tree_hpp_ALREADY_INCLUDED
+#define HEADER_cook_bench_Tree_hpp_ALREADY_INCLUDED
+
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <ostream>
+#include <string>
+
+namespace cook { namespace bench {
+
+    //The shape of a synthetic recipe tree: every book has its own script that is included from the root script
+    struct TreeConfig
+    {
+        unsigned int books = 10;
+        unsigned int recipes = 10;
+        unsigned int sources = 10;
+        unsigned int headers = 5;
+        //Number of dependencies of each recipe, on recipes that come earlier in the tree
+        unsigned int fanout = 3;
+        //Number of nested directories the sources of a recipe are spread over
+        unsigned int depth = 2;
+
+        Result set(const std::string & key, const std::string & value);
+        void stream(std::ostream & os) const;
+    };
+
+    //Writes the scripts and the (empty) sources of the tree under dir, the root script is dir/recipes.chai
+    Result generate(const TreeConfig & config, const std::filesystem::path & dir);
+
+} }
+
+#endif
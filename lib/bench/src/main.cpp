@@ -0,0 +1,139 @@
+#include "cook/bench/Tree.hpp"
+#include "cook/bench/Measure.hpp"
+#include "cook/chai/Context.hpp"
+#include "cook/process/chef/CompileArchiveLink.hpp"
+#include "cook/generator/Interface.hpp"
+#include "cook/log/Scope.hpp"
+#include "gubg/mss.hpp"
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace cook;
+
+namespace {
+
+    struct Options
+    {
+        bench::TreeConfig tree;
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "cook_bench";
+        std::list<std::string> generators = {"ninja", "CMake", "naft"};
+
+        Result parse(int argc, const char ** argv)
+        {
+            MSS_BEGIN(Result);
+
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string arg = argv[i];
+                const auto ix = arg.find('=');
+                MSG_MSS(ix != std::string::npos, Error, "Expected key=value, got '" << arg << "'");
+                const std::string key = arg.substr(0, ix);
+                const std::string value = arg.substr(ix+1);
+
+                if (false) {}
+                else if (key == "dir")
+                    dir = value;
+                else if (key == "generators")
+                {
+                    generators.clear();
+                    std::istringstream iss(value);
+                    for (std::string name; std::getline(iss, name, ','); )
+                        if (!name.empty())
+                            generators.push_back(name);
+                }
+                else
+                    MSS(tree.set(key, value));
+            }
+
+            MSS_END();
+        }
+    };
+
+    //Runs every phase of a cook invocation on the generated tree, and reports each of them
+    Result run(const Options & options)
+    {
+        MSS_BEGIN(Result);
+
+        std::ostream & os = std::cout;
+        os << "{\"config\": ";
+        options.tree.stream(os);
+        os << "}" << std::endl;
+
+        auto phase = [&](const std::string & name, auto && ftor)
+        {
+            bench::Measurement measurement;
+            Result rc = ftor();
+            bench::stream_sample(os, name, measurement.seconds(), measurement.allocations());
+            return rc;
+        };
+
+        MSS(phase("generate", [&]() { return bench::generate(options.tree, options.dir / "tree"); }));
+
+        //Log scopes below the log level create no node: these should not allocate
+        MSS(phase("log: filtered scopes", [&]() {
+            const int level = log::level();
+            log::set_level(0);
+            for (unsigned int i = 0; i < 100000; ++i)
+            {
+                auto ss = log::scope("filtered", -1, [&](auto & n) { n.attr("index", i).attr("name", options.dir.string()); });
+                auto ss2 = log::scope("child");
+            }
+            log::set_level(level);
+            return Result();
+        }));
+
+        auto kitchen_ptr = std::make_unique<chai::Context>();
+        chai::Context & kitchen = *kitchen_ptr;
+        kitchen.dirs().set_output(options.dir / "output");
+        kitchen.dirs().set_temporary(options.dir / "temporary");
+
+        MSS(phase("toolchain", [&]() { return kitchen.load_toolchain("default"); }));
+        MSS(phase("initialize", [&]() { return kitchen.initialize(); }));
+        MSS(phase("load", [&]() { return kitchen.load_recipe((options.dir / "tree" / "recipes.chai").string()); }));
+
+        const std::list<model::Recipe *> roots = kitchen.lib().list_all_recipes();
+        MSS(phase("resolve", [&]() { return kitchen.lib().resolve(roots); }));
+        MSS(phase("menu", [&]() { return kitchen.menu().construct(gubg::make_range(roots)); }));
+
+        process::chef::CompileArchiveLink chef(false);
+        process::chef::Interface::Timings timings;
+        chef.set_timings(&timings);
+        MSS(chef.initialize());
+        MSS(phase("chef", [&]() { return chef.mis_en_place(kitchen); }));
+        for (const auto & p: timings)
+            bench::stream_sample(os, "souschef: " + p.first, p.second.count());
+
+        for (const auto & name: options.generators)
+        {
+            auto generator = kitchen.get_generator(name);
+            MSG_MSS(!!generator, Error, "Unknown generator '" << name << "'");
+            MSS(phase("generator: " + name, [&]() { return generator->process(kitchen); }));
+        }
+
+        //The cost the cook executable avoids by not destroying its state at exit
+        MSS(phase("teardown", [&]() { kitchen_ptr.reset(); return Result(); }));
+
+        MSS_END();
+    }
+
+    void write(const Result & result)
+    {
+        result.each_message([](const Message & msg) {
+            if (msg.type_ == Message::Error || msg.type_ == Message::InternalError)
+                std::cerr << msg.type_ << ": " << msg.msg_ << std::endl;
+        });
+    }
+
+}
+
+int main(int argc, const char ** argv)
+{
+    Options options;
+    Result rc = options.parse(argc, argv);
+    if (rc)
+        rc = run(options);
+
+    write(rc);
+    return rc ? 0 : 1;
+}
@@ -6,12 +6,14 @@
 #include "cook/generator/Naft.hpp"
 #include "cook/generator/Ninja.hpp"
 #include "cook/generator/HTML.hpp"
+#include "cook/generator/BuildTime.hpp"
 #include "cook/process/toolchain/Manager.hpp"
 #include "gubg/mss.hpp"
 #include "gubg/Strange.hpp"
 #include <cassert>
 #include <algorithm>
 #include <cctype>
+#include <thread>
 
 namespace  { 
     /* const char *logns = ""; */
@@ -27,10 +29,20 @@ namespace  {
 
 namespace cook {
 
+// the toolchain is created upfront, concurrent readers never have to create it
+Context::Context()
+    : toolchain_ptr_(std::make_shared<process::toolchain::Manager>())
+{
+}
+
 Result Context::initialize()
 {
     MSS_BEGIN(Result);
 
+    auto is_set = [&](const std::string & key) { return toolchain_().has_config(key); };
+    for (const auto & p: optimization_defaults(is_set))
+        toolchain_().add_config(p.first, p.second);
+
     MSS(toolchain_().initialize());
 
     // add the generators
@@ -40,15 +52,36 @@ Result Context::initialize()
     MSS(register_generator(std::make_shared<generator::Naft>()));
     MSS(register_generator(std::make_shared<generator::Ninja>()));
     MSS(register_generator(std::make_shared<generator::HTML>()));
+    MSS(register_generator(std::make_shared<generator::BuildTime>()));
 
     MSS_END();
 }
 
+std::map<std::string, std::string> Context::optimization_defaults(const std::function<bool (const std::string &)> & is_set) const
+{
+    std::map<std::string, std::string> defaults;
+
+    //The profiles for profile-guided optimization are kept in the temporary directory, where the instrumented and the optimized build can find them
+    if (toolchain_().has_config("pgo") && !is_set("pgo.dir"))
+        defaults["pgo.dir"] = (dirs().temporary(true) / "pgo").string();
+    //The ThinLTO cache survives between builds, by default each link can use all cores and the link pool lets only one run at a time
+    if (toolchain_().has_config("lto"))
+    {
+        if (!is_set("lto.dir"))
+            defaults["lto.dir"] = (dirs().temporary(true) / "lto").string();
+        if (!is_set("lto.jobs"))
+            defaults["lto.jobs"] = std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    return defaults;
+}
+
 Result Context::initialize_menu(const std::list<model::Recipe*> & root_recipes)
 {
     MSS_BEGIN(Result);
 
-    MSS(lib_.resolve());
+    // only the dependencies that are reachable from the root recipes are resolved
+    MSS(lib_.resolve(root_recipes));
     MSS(menu_.construct(gubg::make_range(root_recipes)));
 
     MSS_END();
@@ -119,10 +152,16 @@ void Context::add_toolchain_config(const std::string & key)
     toolchain_().add_config(key);
 }
 
+void Context::share_environment_(const Context & parent)
+{
+    dirs_ = parent.dirs_;
+    project_name_ = parent.project_name_;
+    executable_ = parent.executable_;
+    toolchain_ptr_ = parent.toolchain_ptr_;
+}
+
 process::toolchain::Manager &Context::toolchain_() const
 {
-    if (!toolchain_ptr_)
-        toolchain_ptr_.reset(new process::toolchain::Manager);
     return *toolchain_ptr_;
 }
 const process::toolchain::Manager &Context::toolchain() const
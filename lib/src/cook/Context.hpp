@@ -8,6 +8,10 @@
 #include "cook/model/Dirs.hpp"
 #include "cook/process/Menu.hpp"
 #include <optional>
+#include <list>
+#include <set>
+#include <map>
+#include <functional>
 
 namespace cook {
 
@@ -27,6 +31,7 @@ namespace cook {
         using Variable = std::pair<std::string, std::string>;
         using ToolchainManagerPtr = std::shared_ptr<process::toolchain::Manager>;
 
+        Context();
         virtual ~Context() {}
 
         Result initialize();
@@ -35,6 +40,9 @@ namespace cook {
 
         Result initialize_menu(const std::list<model::Recipe*> & root_recipes);
 
+        //The toolchain options that profile-guided and link-time optimization need, for the keys that are not set explicitly
+        std::map<std::string, std::string> optimization_defaults(const std::function<bool (const std::string &)> & is_set) const;
+
         // getters and setter
         model::Book * root_book() const;
         model::Dirs & dirs()                        { return dirs_; }
@@ -44,10 +52,20 @@ namespace cook {
         const model::Library & lib() const          { return lib_; }
         const std::string & project_name() const    { return project_name_; }
         void set_project_name(const std::string & name) { project_name_ = name; }
+        //The cook executable itself, used for commands that cook runs during the build
+        const std::filesystem::path & executable() const { return executable_; }
+        void set_executable(const std::filesystem::path & executable) { executable_ = executable; }
+        //The arguments and working directory cook was started with, the generated build reruns cook with them
+        const std::list<std::string> & arguments() const { return arguments_; }
+        const std::filesystem::path & working_directory() const { return working_directory_; }
+        void set_invocation(const std::list<std::string> & arguments, const std::filesystem::path & working_directory) { arguments_ = arguments; working_directory_ = working_directory; }
+        //The scripts the recipes and toolchain were loaded from, including the ones skipped via the manifest
+        const std::set<std::filesystem::path> & scripts() const { return scripts_; }
         OS os() const;
 
         void add_toolchain_config(const std::string & key, const std::string & value);
         void add_toolchain_config(const std::string & key);
+        //The const accessors are safe to use from concurrent generators
         const process::toolchain::Manager &toolchain() const;
         process::toolchain::Manager & toolchain();
 
@@ -58,14 +76,23 @@ namespace cook {
 
         virtual Result set_variable(const std::string & name, const std::string & value) = 0;
 
+    protected:
+        //Copies the directories and project settings of parent, and shares its toolchain
+        void share_environment_(const Context & parent);
+        void add_script_(const std::filesystem::path & script) { scripts_.insert(script); }
+
     private:
         std::map<std::string, GeneratorPtr> generators_;
         model::Library lib_;
         model::Dirs dirs_;
         process::Menu menu_;
         std::string project_name_;
+        std::filesystem::path executable_;
+        std::list<std::string> arguments_;
+        std::filesystem::path working_directory_;
+        std::set<std::filesystem::path> scripts_;
 
-        mutable ToolchainManagerPtr toolchain_ptr_;
+        ToolchainManagerPtr toolchain_ptr_;
         process::toolchain::Manager &toolchain_() const;
     };
 
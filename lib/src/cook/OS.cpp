@@ -1,5 +1,16 @@
 #include "cook/OS.hpp"
 #include "gubg/platform.h"
+#if GUBG_PLATFORM_OS_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#if GUBG_PLATFORM_OS_OSX
+#include <sys/sysctl.h>
+#endif
 
 namespace cook {
 
@@ -20,6 +31,29 @@ OS get_os()
     throw std::runtime_error("Unsupported operating system");
 }
 
+std::uint64_t physical_memory()
+{
+#if GUBG_PLATFORM_OS_WINDOWS
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (!GlobalMemoryStatusEx(&status))
+        return 0;
+    return status.ullTotalPhys;
+#elif GUBG_PLATFORM_OS_OSX
+    std::uint64_t memory = 0;
+    std::size_t size = sizeof(memory);
+    if (sysctlbyname("hw.memsize", &memory, &size, nullptr, 0) != 0)
+        return 0;
+    return memory;
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0)
+        return 0;
+    return static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(page_size);
+#endif
+}
+
 std::ostream & operator<<(std::ostream & str, OS os)
 {
     switch(os)
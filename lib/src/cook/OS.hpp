@@ -2,6 +2,7 @@
 #define HEADER_cook_OS_hpp_ALREADY_INCLUDED
 
 #include <ostream>
+#include <cstdint>
 
 namespace cook {
 
@@ -15,6 +16,9 @@ enum class OS
 std::ostream & operator<<(std::ostream & str, OS os);
 OS get_os();
 
+//The physical memory in bytes, or 0 when it cannot be determined
+std::uint64_t physical_memory();
+
 }
 
 #endif
@@ -62,6 +62,7 @@ namespace cook { namespace chai {
         }
 
         Recipe r(recipe, context_);
+        context_->notify_recipe(*recipe);
 
         // set the Type
         if (type)
@@ -18,12 +18,16 @@
 #include "cook/chai/mss.hpp"
 #include "cook/process/toolchain/Manager.hpp"
 #include "cook/process/toolchain/Element.hpp"
+#include "cook/util/Parallel.hpp"
 #include "gubg/std/filesystem.hpp"
 #include "gubg/mss.hpp"
 #include "gubg/chai/inject.hpp"
 #include "chaiscript/chaiscript.hpp"
 #include <stack>
+#include <fstream>
+#include <set>
 #include <functional>
+#include <vector>
 
 namespace cook { namespace chai {
 
@@ -49,6 +53,15 @@ struct Logger : public cook::Logger
     }
 };
 
+//Reports the chai errors of the current thread via logger, until the scope ends
+struct LoggerScope
+{
+    explicit LoggerScope(cook::Logger * logger): previous(get_logger()) { set_logger(logger); }
+    ~LoggerScope() { set_logger(previous); }
+
+    cook::Logger * previous;
+};
+
 }
 
 
@@ -60,28 +73,55 @@ struct Context::Pimpl
     using Engine = chaiscript::ChaiScript_Basic;
 
     Pimpl(model::Book * book, Context * context)
-        : engine(chaiscript::Std_Lib::library(), std::make_unique<Parser>()),
-          cook(book, context)
+        : cook(book, context),
+          kitchen(context)
+    {
+        // the first context is the default for this thread, eg for the callbacks that are run after loading
+        if (!get_logger())
+            set_logger(&logger);
+    }
+    ~Pimpl()
     {
-        set_logger(&logger);
-        gubg::chai::inject<gubg::chai::Regex>(engine);
-        gubg::chai::inject<std::string>(engine);
-        gubg::chai::inject<gubg::chai::File>(engine);
-        gubg::chai::inject<gubg::chai::Date>(engine);
-        gubg::chai::inject<gubg::chai::Time>(engine);
+        if (get_logger() == &logger)
+            set_logger(nullptr);
+    }
+
+    //The engine is only constructed when the first script is evaluated: invocations that do not
+    //evaluate scripts (eg the module collation called from the build) skip its considerable setup.
+    //All modules are registered at once: chaiscript cannot resolve an unknown name on first use, and
+    //types like Uri or UserData reach scripts through other modules without being named
+    Engine & engine()
+    {
+        if (!engine_)
+        {
+            engine_ = std::make_unique<Engine>(chaiscript::Std_Lib::library(), std::make_unique<Parser>());
+            gubg::chai::inject<gubg::chai::Regex>(*engine_);
+            gubg::chai::inject<std::string>(*engine_);
+            gubg::chai::inject<gubg::chai::File>(*engine_);
+            gubg::chai::inject<gubg::chai::Date>(*engine_);
+            gubg::chai::inject<gubg::chai::Time>(*engine_);
+            initialize_engine_(*engine_, kitchen);
+        }
+        return *engine_;
     }
 
     Logger logger;
-    Engine engine;
     std::stack<std::filesystem::path> scripts;
+    //The canonical paths of the scripts, as used in the manifest
+    std::stack<std::filesystem::path> manifest_scripts;
+    //The names that the scripts declared so far made visible to the scripts that are evaluated later
+    std::set<std::string> global_names;
     Cook cook;
+    Context * kitchen;
+    std::unique_ptr<Engine> engine_;
     using ElementType = process::toolchain::Element::Type; 
 
-    void initialize_engine_(Context * kitchen)
+    void initialize_engine_(Engine & engine, Context * kitchen)
     {
         engine.add(chaiscript::fun([=](const std::string & name) { kitchen->load_(name); }), "load");
         engine.add(chaiscript::fun([=](const std::string & name) { kitchen->include_(name); }), "include");
         engine.add(chaiscript::fun([=](const std::string & name) { kitchen->include_relative_(name); }), "include_relative");
+        engine.add(chaiscript::fun([=](const std::string & name) { kitchen->include_isolated_(name); }), "include_isolated");
         engine.add(module::flags());
         engine.add(module::basic());
         engine.add(module::uri());
@@ -92,13 +132,13 @@ struct Context::Pimpl
         engine.add(module::recipe());
         engine.add(module::cook());
 
-        add_ingredient_constructors(kitchen);
+        add_ingredient_constructors(engine, kitchen);
         engine.add(user_data_module());
         engine.add_global(chaiscript::var(cook.root()), "root");
         engine.add_global(chaiscript::var(std::ref(cook)), "cook");
     }
 
-    void add_ingredient_constructors(const Context * context)
+    void add_ingredient_constructors(Engine & engine, const Context * context)
     {
         {
             auto lambda = [=](const std::string & dir, const std::string & rel)
@@ -129,6 +169,7 @@ struct Context::Pimpl
     }
 
 
+
     std::filesystem::path top_level_path() const
     {
         if (scripts.empty())
@@ -146,7 +187,17 @@ const cook::Logger & Context::logger() const
 Context::Context()
     : pimpl_(std::make_unique<Pimpl>(root_book(), this))
 {
-    pimpl_->initialize_engine_(this);
+}
+
+Context::Context(const Context * parent)
+{
+    // the environment is shared before the chai toolchain is bound to it
+    share_environment_(*parent);
+    data_ = parent->data_.clone();
+    pimpl_ = std::make_unique<Pimpl>(root_book(), this);
+
+    // the toolchain is shared with the concurrently evaluated isolated scripts, these can only read it
+    pimpl_->cook.freeze_toolchain();
 }
 
 
@@ -214,26 +265,27 @@ Result Context::load_toolchain(const std::string & toolchain)
     std::filesystem::path fn;
     MSS(loader.load(toolchain, fn));
 
-    MSS(run_(fn.string()));
+    MSS(run_([&]() { include_(fn.string()); }));
     MSS_END();
 }
 
 Result Context::load_recipe(const std::string & recipe)
 {
     MSS_BEGIN(Result);
-    MSS(run_(recipe));
+    MSS(run_([&]() { include_(recipe); }));
     MSS_END();
 }
 
 
-Result Context::run_(const std::string & recipe)
+Result Context::run_(const std::function<void ()> & eval)
 {
     MSS_BEGIN(Result);
 
+    LoggerScope logger_scope(&pimpl_->logger);
+
     try
     {
-        // create and initialize the engine
-        include_(recipe);
+        eval();
     }
     // TODO: add better error handling
     catch(Error & error)
@@ -262,6 +314,72 @@ Result Context::run_(const std::string & recipe)
         MSG_MSS(false, InternalError, "Boxed_Value");
     }
 
+    MSS(process_isolated_());
+
+    MSS_END();
+}
+
+Result Context::process_isolated_()
+{
+    MSS_BEGIN(Result);
+
+    if (isolated_.empty())
+        MSS_RETURN_OK();
+
+    auto ss = log::scope("isolated scripts", [&](auto & n) { n.attr("count", isolated_.size()); });
+
+    // the contexts and their engines are set up here, one after the other: only the evaluation of the scripts
+    // runs concurrently, each in its own engine, and the engine setup is not known to be thread-safe
+    std::vector<Isolated *> jobs;
+    for (auto & isolated: isolated_)
+    {
+        isolated.context.reset(new Context(this));
+        isolated.context->skippable_ = skippable_;
+        if (manifest_)
+            isolated.context->set_manifest(&isolated.manifest);
+        isolated.context->pimpl_->engine();
+        jobs.push_back(&isolated);
+    }
+
+    // the workers start without a chai logger: until a context sets its own, they report via the one of this thread
+    cook::Logger * logger = get_logger();
+    util::parallel_for(jobs.size(), [&](std::size_t ix)
+    {
+        LoggerScope logger_scope(logger);
+        Isolated & isolated = *jobs[ix];
+        Context & context = *isolated.context;
+        try
+        {
+            isolated.result = context.run_([&]() { context.try_include(isolated.script); });
+        }
+        catch (const std::exception & exc)
+        {
+            isolated.result << Message(Message::Type::InternalError, std::string("Unexpected exception while evaluating ") + isolated.script.string() + ": " + exc.what());
+        }
+    });
+
+    // merge in the order of inclusion, independent of the order of evaluation
+    Result rc;
+    for (auto & isolated: isolated_)
+    {
+        rc.merge(isolated.result);
+        if (!isolated.result)
+            continue;
+
+        Context & context = *isolated.context;
+        for (const auto & script: context.scripts())
+            add_script_(script);
+        if (manifest_)
+            // the isolated script is top-level in its own context
+            manifest_->merge(isolated.manifest, isolated.parent);
+
+        rc.merge(root_book()->merge(*context.root_book()));
+        isolates_.push_back(std::move(isolated.context));
+    }
+    isolated_.clear();
+
+    MSS(rc);
+
     MSS_END();
 }
 
@@ -270,6 +388,22 @@ std::filesystem::path Context::current_working_directory() const
     return pimpl_->top_level_path();
 }
 
+void Context::notify_recipe(const model::Recipe & recipe) const
+{
+    if (!manifest_ || pimpl_->manifest_scripts.empty())
+        return;
+
+    manifest_->goc_script(pimpl_->manifest_scripts.top()).recipes.insert(recipe.uri().string());
+}
+
+void Context::notify_global_effect() const
+{
+    if (!manifest_ || pimpl_->manifest_scripts.empty())
+        return;
+
+    manifest_->goc_script(pimpl_->manifest_scripts.top()).has_global_effects = true;
+}
+
 void Context::load_(const std::string & file)
 {
     // make the path to the file
@@ -290,18 +424,63 @@ void Context::load_script_(const std::filesystem::path & fn)
         n.attr("filename", fn.string());
     });
 
-    // push the script
+    std::error_code ec;
+    std::filesystem::path manifest_fn = std::filesystem::canonical(fn, ec);
+    if (ec)
+        manifest_fn = fn;
+    add_script_(manifest_fn);
+
+    if (!manifest_)
+    {
+        // push the script
+        pimpl_->scripts.push(fn);
+        pimpl_->engine().eval_file(fn.string());
+        pimpl_->scripts.pop();
+        return;
+    }
+
+    {
+        auto & script = manifest_->goc_script(manifest_fn);
+        if (!pimpl_->manifest_scripts.empty())
+            script.parent = pimpl_->manifest_scripts.top();
+        Manifest::file_info(script.size, script.mtime, fn);
+    }
+    {
+        // any declaration or assignment of a global can be used by the scripts that are evaluated later
+        std::ifstream fi(fn.string());
+        if (Manifest::writes_globals(fi, pimpl_->global_names))
+            manifest_->goc_script(manifest_fn).has_global_effects = true;
+    }
+
     pimpl_->scripts.push(fn);
-    pimpl_->engine.eval_file(fn.string());
+    pimpl_->manifest_scripts.push(manifest_fn);
+    pimpl_->engine().eval_file(fn.string());
+    pimpl_->manifest_scripts.pop();
     pimpl_->scripts.pop();
+}
 
+void Context::set_skippable_scripts(const std::set<std::filesystem::path> & scripts, const Manifest & manifest)
+{
+    skippable_.clear();
+    for (const auto & fn: scripts)
+        skippable_[fn] = manifest.included_scripts(fn);
 }
 
-bool Context::try_include(std::filesystem::path fn)
+void Context::skip_script_(const std::filesystem::path & fn)
+{
+    // a skipped script and the scripts it would include still determine the recipes
+    add_script_(fn);
+    auto it = skippable_.find(fn);
+    if (it != skippable_.end())
+        for (const auto & included: it->second)
+            add_script_(included);
+}
+
+bool Context::find_script_(std::filesystem::path & fn)
 {
     if (std::filesystem::is_directory(fn))
         fn /= "recipes.chai";
-    
+
     // does the file exist?
     if (!std::filesystem::exists(fn))
     {
@@ -310,9 +489,22 @@ bool Context::try_include(std::filesystem::path fn)
             return false;
     }
 
-    std::filesystem::path p = std::filesystem::canonical(fn);
-    if (imported_.insert(p).second)
-        load_script_(p);
+    fn = std::filesystem::canonical(fn);
+    return true;
+}
+
+bool Context::try_include(std::filesystem::path fn)
+{
+    if (!find_script_(fn))
+        return false;
+
+    if (!imported_.insert(fn).second)
+        return true;
+
+    if (skippable_.count(fn) == 0)
+        load_script_(fn);
+    else
+        skip_script_(fn);
 
     return true;
 }
@@ -339,4 +531,43 @@ void Context::include_relative_(const std::string& file)
     throw Error(r);
 }
 
+void Context::include_isolated_(const std::string & file)
+{
+    // same lookup as include_(), but the script is only queued
+    std::filesystem::path fn;
+    bool found = false;
+    for(const auto & d : dirs().include_dirs())
+    {
+        fn = gubg::filesystem::combine(d, file);
+        if ((found = find_script_(fn)))
+            break;
+    }
+    if (!found)
+    {
+        fn = gubg::filesystem::combine(pimpl_->top_level_path(), file);
+        found = find_script_(fn);
+    }
+
+    if (!found)
+    {
+        Result r;
+        r << Message(Message::Type::Error, "Could not import file");
+        throw Error(r);
+    }
+
+    if (!imported_.insert(fn).second)
+        return;
+    if (skippable_.count(fn) > 0)
+    {
+        skip_script_(fn);
+        return;
+    }
+
+    Isolated isolated;
+    isolated.script = fn;
+    if (!pimpl_->manifest_scripts.empty())
+        isolated.parent = pimpl_->manifest_scripts.top();
+    isolated_.push_back(std::move(isolated));
+}
+
 } }
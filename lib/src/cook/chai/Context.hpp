@@ -2,8 +2,12 @@
 #define HEADER_cook_chai_Context_hpp_ALREADY_INCLUDED
 
 #include "cook/chai/UserData.hpp"
+#include "cook/chai/Manifest.hpp"
 #include "cook/process/toolchain/Loader.hpp"
 #include "cook/Context.hpp"
+#include <functional>
+#include <list>
+#include <map>
 
 namespace cook { namespace chai {
 
@@ -20,20 +24,52 @@ public:
     Result load_toolchain(const std::string & toolchain);
     std::filesystem::path current_working_directory() const;
 
+    //Records the loaded scripts and the recipes they touch into manifest
+    void set_manifest(Manifest * manifest) { manifest_ = manifest; }
+    //Included scripts that are not evaluated, as computed from manifest, the previous one
+    void set_skippable_scripts(const std::set<std::filesystem::path> & scripts, const Manifest & manifest);
+    void notify_recipe(const model::Recipe & recipe) const;
+    //The script that is being evaluated changes the toolchain, which the scripts that are evaluated later can depend on
+    void notify_global_effect() const;
+
 private:
-    Result run_(const std::string & filename);
+    Result run_(const std::function<void ()> & eval);
     void load_script_(const std::filesystem::path & fn);
 
+    static bool find_script_(std::filesystem::path & fn);
     bool try_include(std::filesystem::path fn);
     void load_(const std::string & file);
     void include_(const std::string & file);
     void include_relative_(const std::string & file);
+    void include_isolated_(const std::string & file);
+    void skip_script_(const std::filesystem::path & fn);
+    Result process_isolated_();
     void reset_engine_();
+    //An isolated context, sharing the environment and a frozen toolchain with its parent
+    explicit Context(const Context * parent);
 
     struct Pimpl;
     std::unique_ptr<Pimpl> pimpl_;
     UserData data_;
     std::set<std::filesystem::path> imported_;
+    //The scripts that a skippable script would include
+    std::map<std::filesystem::path, std::set<std::filesystem::path>> skippable_;
+    Manifest * manifest_ = nullptr;
+
+    //A script that is evaluated in its own engine and library, concurrently with the other isolated scripts
+    struct Isolated
+    {
+        std::filesystem::path script;
+        //The including script, as known in the manifest
+        std::filesystem::path parent;
+        std::unique_ptr<Context> context;
+        //The scripts loaded by context, merged into the manifest of the parent
+        Manifest manifest;
+        Result result;
+    };
+    std::list<Isolated> isolated_;
+    //The recipes of an isolated script can hold callbacks into its engine
+    std::list<std::unique_ptr<Context>> isolates_;
 };
 
 } }
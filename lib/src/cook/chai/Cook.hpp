@@ -24,6 +24,7 @@ namespace cook { namespace chai {
         std::string project_name() const;
         void set_project_name(const std::string & name);
         Toolchain toolchain() const;
+        void freeze_toolchain() { toolchain_.freeze(); }
 
         std::string output_directory() const;
         std::string temporary_directory() const;
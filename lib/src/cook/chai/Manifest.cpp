@@ -0,0 +1,333 @@
+#include "cook/chai/Manifest.hpp"
+#include "cook/util/File.hpp"
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+namespace cook { namespace chai {
+
+    namespace {
+
+        const char * header = "cook manifest v1";
+
+        std::vector<std::string> split_tabs(const std::string & line)
+        {
+            std::vector<std::string> fields;
+            std::istringstream iss(line);
+            std::string field;
+            while (std::getline(iss, field, '\t'))
+                fields.push_back(field);
+            return fields;
+        }
+
+    }
+
+    void Manifest::clear()
+    {
+        key_.clear();
+        scripts_.clear();
+        dependencies_.clear();
+    }
+
+    Manifest::Script & Manifest::goc_script(const std::filesystem::path & fn)
+    {
+        return scripts_[fn];
+    }
+
+    void Manifest::add_dependency(const std::string & recipe, const std::string & dependency)
+    {
+        dependencies_[recipe].insert(dependency);
+    }
+
+    void Manifest::merge(const Manifest & rhs, const std::filesystem::path & parent)
+    {
+        for (const auto & p: rhs.scripts_)
+        {
+            const Script & src = p.second;
+            auto it = scripts_.find(p.first);
+            if (it == scripts_.end())
+            {
+                Script & dst = scripts_[p.first];
+                dst = src;
+                if (dst.parent.empty())
+                    dst.parent = parent;
+                continue;
+            }
+
+            //A script that was also loaded elsewhere touches the recipes of both loads
+            Script & dst = it->second;
+            dst.has_global_effects = dst.has_global_effects || src.has_global_effects;
+            dst.recipes.insert(src.recipes.begin(), src.recipes.end());
+        }
+        for (const auto & p: rhs.dependencies_)
+            dependencies_[p.first].insert(p.second.begin(), p.second.end());
+    }
+
+    std::set<std::filesystem::path> Manifest::included_scripts(const std::filesystem::path & fn) const
+    {
+        std::set<std::filesystem::path> included;
+        std::list<std::filesystem::path> todo = {fn};
+        while (!todo.empty())
+        {
+            const auto parent = todo.front();
+            todo.pop_front();
+            for (const auto & p: scripts_)
+                if (p.second.parent == parent && included.insert(p.first).second)
+                    todo.push_back(p.first);
+        }
+        return included;
+    }
+
+    void Manifest::file_info(std::uintmax_t & size, std::int64_t & mtime, const std::filesystem::path & fn)
+    {
+        std::error_code ec;
+        size = std::filesystem::file_size(fn, ec);
+        if (ec)
+            size = static_cast<std::uintmax_t>(-1);
+        const auto time = std::filesystem::last_write_time(fn, ec);
+        mtime = ec ? -1 : static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    bool Manifest::writes_globals(std::istream & is, std::set<std::string> & globals)
+    {
+        const std::string text{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+        const auto size = text.size();
+        auto at = [&](std::size_t ix) { return ix < size ? text[ix] : '\0'; };
+        auto is_word = [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'; };
+
+        bool writes = false;
+        unsigned int depth = 0;
+        //The keyword whose name is expected next, and the brace depth it was found at
+        std::string declaration;
+        unsigned int declaration_depth = 0;
+        char previous = '\0';
+
+        for (std::size_t ix = 0; ix < size; )
+        {
+            const char ch = text[ix];
+            if (ch == '/' && at(ix+1) == '/')
+            {
+                for (; ix < size && text[ix] != '\n'; ++ix) {}
+            }
+            else if (ch == '/' && at(ix+1) == '*')
+            {
+                const auto end = text.find("*/", ix+2);
+                ix = (end == std::string::npos ? size : end+2);
+            }
+            else if (ch == '"' || ch == '\'')
+            {
+                for (++ix; ix < size && text[ix] != ch; ++ix)
+                    if (text[ix] == '\\')
+                        ++ix;
+                ++ix;
+                previous = ch;
+            }
+            else if (is_word(ch))
+            {
+                const auto begin = ix;
+                for (; ix < size && is_word(text[ix]); ++ix) {}
+                const std::string word = text.substr(begin, ix-begin);
+
+                if (!declaration.empty())
+                {
+                    //Variables and functions at the top level outlive the script, `global` ones always do
+                    if (declaration == "global" || declaration == "GLOBAL" || declaration_depth == 0)
+                    {
+                        writes = true;
+                        globals.insert(word);
+                    }
+                    declaration.clear();
+                }
+                else if (word == "global" || word == "GLOBAL" || word == "var" || word == "auto" || word == "def" || word == "attr" || word == "class")
+                {
+                    declaration = word;
+                    declaration_depth = depth;
+                }
+                else if (previous != '.' && globals.count(word) > 0)
+                {
+                    //An assignment to a name that is visible to other scripts
+                    auto op = ix;
+                    for (; op < size && std::isspace(static_cast<unsigned char>(text[op])); ++op) {}
+                    const bool compound = std::string("+-*/%&|^").find(at(op)) != std::string::npos && at(op) != '\0';
+                    if (compound)
+                        ++op;
+                    if (at(op) == '=' && at(op+1) != '=')
+                        writes = true;
+                }
+                previous = 'a';
+            }
+            else
+            {
+                if (ch == '{')
+                    ++depth;
+                else if (ch == '}' && depth > 0)
+                    --depth;
+                if (!std::isspace(static_cast<unsigned char>(ch)))
+                    previous = ch;
+                ++ix;
+            }
+        }
+        return writes;
+    }
+
+    bool Manifest::is_up_to_date(const std::string & key) const
+    {
+        if (scripts_.empty() || key != key_)
+            return false;
+
+        for (const auto & p: scripts_)
+        {
+            std::uintmax_t size;
+            std::int64_t mtime;
+            file_info(size, mtime, p.first);
+            if (size != p.second.size || mtime != p.second.mtime)
+                return false;
+        }
+        return true;
+    }
+
+    bool Manifest::skippable_scripts(std::set<std::filesystem::path> & skippable, const std::list<std::string> & roots) const
+    {
+        MSS_BEGIN(bool);
+
+        skippable.clear();
+
+        //The recipes that are needed: the closure of the roots
+        std::set<std::string> closure;
+        {
+            std::set<std::string> known;
+            for (const auto & p: scripts_)
+                known.insert(p.second.recipes.begin(), p.second.recipes.end());
+
+            std::list<std::string> todo;
+            for (const auto & root: roots)
+            {
+                MSS(known.count(root) > 0);
+                todo.push_back(root);
+            }
+
+            while (!todo.empty())
+            {
+                const std::string uri = todo.front();
+                todo.pop_front();
+                if (!closure.insert(uri).second)
+                    continue;
+
+                auto it = dependencies_.find(uri);
+                if (it != dependencies_.end())
+                    todo.insert(todo.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        //A script is needed when it touches the closure or has global effects, and so are the scripts that include it
+        std::set<std::filesystem::path> needed;
+        for (const auto & p: scripts_)
+        {
+            const Script & script = p.second;
+            bool is_needed = script.has_global_effects || script.parent.empty();
+            for (const auto & uri: script.recipes)
+                is_needed = is_needed || closure.count(uri) > 0;
+            if (!is_needed)
+                continue;
+
+            for (auto fn = p.first; !fn.empty() && needed.insert(fn).second; )
+            {
+                auto it = scripts_.find(fn);
+                fn = (it == scripts_.end() ? std::filesystem::path() : it->second.parent);
+            }
+        }
+
+        for (const auto & p: scripts_)
+            if (needed.count(p.first) == 0)
+                skippable.insert(p.first);
+
+        MSS_END();
+    }
+
+    void Manifest::stream(std::ostream & os) const
+    {
+        os << header << std::endl;
+        os << "key\t" << key_ << std::endl;
+        for (const auto & p: scripts_)
+        {
+            const Script & script = p.second;
+            os << "script\t" << p.first.string() << "\t" << script.parent.string() << "\t" << script.size << "\t" << script.mtime << "\t" << (script.has_global_effects ? 1 : 0) << std::endl;
+            for (const auto & uri: script.recipes)
+                os << "recipe\t" << uri << std::endl;
+        }
+        for (const auto & p: dependencies_)
+            for (const auto & dependency: p.second)
+                os << "dependency\t" << p.first << "\t" << dependency << std::endl;
+    }
+
+    Result Manifest::parse(std::istream & is)
+    {
+        MSS_BEGIN(Result);
+
+        clear();
+
+        std::string line;
+        MSG_MSS(std::getline(is, line) && line == header, Error, "Unexpected manifest header");
+
+        Script * script = nullptr;
+        for (unsigned int nr = 2; std::getline(is, line); ++nr)
+        {
+            const auto fields = split_tabs(line);
+            MSG_MSS(!fields.empty(), Error, "Empty line " << nr << " in manifest");
+
+            const std::string & tag = fields[0];
+            if (false) {}
+            else if (tag == "key" && fields.size() <= 2)
+            {
+                key_ = (fields.size() == 2 ? fields[1] : std::string());
+            }
+            else if (tag == "script" && fields.size() == 6)
+            {
+                script = &goc_script(fields[1]);
+                script->parent = fields[2];
+                std::istringstream size(fields[3]), mtime(fields[4]);
+                MSG_MSS(size >> script->size && mtime >> script->mtime, Error, "Invalid file information on line " << nr << " in manifest");
+                script->has_global_effects = (fields[5] == "1");
+            }
+            else if (tag == "recipe" && fields.size() == 2 && !!script)
+            {
+                script->recipes.insert(fields[1]);
+            }
+            else if (tag == "dependency" && fields.size() == 3)
+            {
+                add_dependency(fields[1], fields[2]);
+            }
+            else
+            {
+                MSG_MSS(false, Error, "Unexpected line " << nr << " in manifest");
+            }
+        }
+
+        MSS_END();
+    }
+
+    Result Manifest::read(const std::filesystem::path & fn)
+    {
+        MSS_BEGIN(Result);
+
+        std::ifstream fi(fn);
+        MSS_Q(fi.good());
+        MSS(parse(fi));
+
+        MSS_END();
+    }
+
+    Result Manifest::write(const std::filesystem::path & fn) const
+    {
+        MSS_BEGIN(Result);
+
+        std::ostringstream oss;
+        stream(oss);
+        MSS(util::write_if_changed(fn, oss.str()));
+
+        MSS_END();
+    }
+
+} }
@@ -0,0 +1,74 @@
+#ifndef HEADER_cook_chai_Manifest_hpp_ALREADY_INCLUDED
+#define HEADER_cook_chai_Manifest_hpp_ALREADY_INCLUDED
+
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <list>
+#include <map>
+#include <set>
+
+namespace cook { namespace chai {
+
+    //Records which scripts touched which recipes during a full load, and the dependencies between these recipes.
+    //A later run that only needs a few root recipes can then skip the included scripts that do not contribute to their closure.
+    class Manifest
+    {
+    public:
+        struct Script
+        {
+            //Empty for the top-level scripts
+            std::filesystem::path parent;
+            std::uintmax_t size = 0;
+            std::int64_t mtime = 0;
+            //Functions, variables or toolchain configuration that other scripts could depend on
+            bool has_global_effects = false;
+            std::set<std::string> recipes;
+        };
+
+        void clear();
+
+        //The key identifies everything besides the scripts that influences their evaluation, eg the command-line options
+        void set_key(const std::string & key) { key_ = key; }
+        const std::string & key() const { return key_; }
+
+        Script & goc_script(const std::filesystem::path & fn);
+        void add_dependency(const std::string & recipe, const std::string & dependency);
+        //Adds the scripts and dependencies recorded by rhs, its top-level scripts get parent
+        void merge(const Manifest & rhs, const std::filesystem::path & parent);
+
+        const std::map<std::filesystem::path, Script> & scripts() const { return scripts_; }
+        //The scripts that fn includes, directly or indirectly
+        std::set<std::filesystem::path> included_scripts(const std::filesystem::path & fn) const;
+
+        //Whether the key matches and all scripts still have their recorded size and modification time
+        bool is_up_to_date(const std::string & key) const;
+
+        //The included scripts that do not touch the closure of the root recipes.
+        //Returns false when a root recipe is unknown: a full load is needed then.
+        bool skippable_scripts(std::set<std::filesystem::path> & skippable, const std::list<std::string> & roots) const;
+
+        void stream(std::ostream & os) const;
+        Result parse(std::istream & is);
+
+        Result read(const std::filesystem::path & fn);
+        Result write(const std::filesystem::path & fn) const;
+
+        static void file_info(std::uintmax_t & size, std::int64_t & mtime, const std::filesystem::path & fn);
+
+        //Conservative check whether a script changes the globals that later scripts can see: top-level declarations,
+        //`global` variables and assignments to the names in globals. The names it declares are added to globals.
+        static bool writes_globals(std::istream & is, std::set<std::string> & globals);
+
+    private:
+        std::string key_;
+        std::map<std::filesystem::path, Script> scripts_;
+        std::map<std::string, std::set<std::string>> dependencies_;
+    };
+
+} }
+
+#endif
@@ -250,6 +250,25 @@ namespace cook { namespace chai {
         recipe_->insert(LanguageTypePair(Language::Script, Type::Executable), kv);
     }
 
+    void Recipe::toolchain_option(const std::string & key, const Flags & flags)
+    {
+        toolchain_option(key, "true", flags);
+    }
+
+    void Recipe::toolchain_option(const std::string & key, const std::string & value, const Flags & flags)
+    {
+        CHAI_MSS_BEGIN();
+        CHAI_MSS(flags.only({Flag::Propagation, Flag::Overwrite} ));
+
+        auto kv = ingredient::KeyValue(key, value);
+        kv.set_content(Content::User);
+        kv.set_propagation(flags.get_or(Propagation::Private));
+        kv.set_overwrite(flags.get_or(Overwrite::IfSame));
+        kv.set_owner(recipe_);
+
+        recipe_->insert(LanguageTypePair(Language::Undefined, Type::ToolchainOption), kv);
+    }
+
     bool Recipe::add_file(const std::string & dir, const std::string & rel, const Flags & flags)
     {
         CHAI_MSS_BEGIN();
@@ -289,6 +308,19 @@ namespace cook { namespace chai {
         return recipe_->insert(ltp, key_value);
     }
 
+    bool Recipe::add_output(const std::string & dir, const std::string & rel, const Flags & flags)
+    {
+        CHAI_MSS_BEGIN();
+        auto file = ingredient::File(dir, rel);
+        file.set_content(Content::Generated);
+        file.set_propagation(flags.get_or(Propagation::Public));
+        file.set_overwrite(flags.get_or(Overwrite::IfSame));
+        file.set_owner(recipe_);
+
+        LanguageTypePair ltp(flags.get_or(Language::Undefined), flags.get_or(Type::Undefined));
+        return recipe_->insert(ltp, file);
+    }
+
     void Recipe::each_file(const std::function<void (File &)> & functor)
     {
         const Context * context = context_;
@@ -40,9 +40,14 @@ public:
     void define(const std::string & name, const Flags & flags= Flags());
     void define(const std::string & name, const std::string & value, const Flags & flags = Flags());
     void run(const std::string & command);
+    //A toolchain option for the commands of this recipe, and of its dependents when it is public
+    void toolchain_option(const std::string & key, const Flags & flags = Flags());
+    void toolchain_option(const std::string & key, const std::string & value, const Flags & flags = Flags());
     const model::Uri & uri() const;
 
     bool add_file(const std::string & dir, const std::string & rel, const Flags & flags = Flags());
+    //A file that is generated by the commands of a script recipe
+    bool add_output(const std::string & dir, const std::string & rel, const Flags & flags = Flags());
     bool add_key_value(const std::string & key, const Flags & flags = Flags());
     bool add_key_value(const std::string & key, const std::string & value, const Flags & flags = Flags());
     void each_file(const std::function<void (File &)> & functor);
@@ -1,6 +1,10 @@
 #include "cook/chai/Toolchain.hpp"
 #include "cook/chai/Recipe.hpp"
+#include "cook/chai/Context.hpp"
 #include "cook/process/toolchain/Element.hpp"
+#include "cook/process/toolchain/native/Standard.hpp"
+#include "cook/process/toolchain/native/GCC.hpp"
+#include "cook/process/toolchain/native/MSVC.hpp"
 
 namespace cook { namespace chai {
 
@@ -26,8 +30,15 @@ namespace cook { namespace chai {
             Language lang = language.language().first;
 
             if (is_frozen())
+            {
                 CHAI_MSS_MSG(!!manager_->element(type, lang, target_type), Error, "No toolchain element with type " << type << " and language " << lang << " exists");
-            
+            }
+            else
+            {
+                //The element can be configured through the returned wrapper
+                context_->notify_global_effect();
+            }
+
             ToolchainElement el(manager_->goc_element(type, lang, target_type), context_);
             el.set_freeze_flag(is_frozen());
 
@@ -45,6 +56,7 @@ namespace cook { namespace chai {
         {
             CHAI_MSS_BEGIN();
             CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot add config values");
+            context_->notify_global_effect();
 
             manager_->add_config(key);
         }
@@ -53,6 +65,7 @@ namespace cook { namespace chai {
         {
             CHAI_MSS_BEGIN();
             CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot add config values");
+            context_->notify_global_effect();
 
             manager_->add_config(key, value);
         }
@@ -68,10 +81,18 @@ namespace cook { namespace chai {
 
         bool Toolchain::remove_config_1(const std::string & key)
         {
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot remove config values");
+            context_->notify_global_effect();
+
             return manager_->remove_config(key);
         }
         bool Toolchain::remove_config_2(const std::string & key, const std::string & value)
         {
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot remove config values");
+            context_->notify_global_effect();
+
             return manager_->remove_config(key, value);
         }
 
@@ -81,6 +102,7 @@ namespace cook { namespace chai {
 
             CHAI_MSS_BEGIN();
             CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot add configuration callbacks");
+            context_->notify_global_effect();
 
             auto ctx = context_;
 
@@ -93,6 +115,33 @@ namespace cook { namespace chai {
 
         }
 
+        void Toolchain::configure_native(const std::string & name)
+        {
+            namespace native = process::toolchain::native;
+            using GCCVariant = process::toolchain::serialize::GCCVariant;
+
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot add configuration callbacks");
+            context_->notify_global_effect();
+
+            if (false) {}
+            else if (name == "standard") { native::standard_config(*manager_); }
+            else if (name == "gcc") { native::gcc_config(*manager_, GCCVariant::Genuine); }
+            else if (name == "clang") { native::gcc_config(*manager_, GCCVariant::Clang); }
+            else if (name == "msvc") { native::msvc_config(*manager_); }
+            else
+                CHAI_MSS_MSG(false, Error, "There is no native configuration for toolchain " << name);
+        }
+
+        process::toolchain::Probe & Toolchain::probe(const std::string & compiler)
+        {
+            CHAI_MSS_BEGIN();
+            //Probing fills the cache of the manager, isolated scripts run concurrently and only use the probes of their parent
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot probe compiler " << compiler);
+
+            return manager_->probe(compiler, context_->dirs().temporary(true) / "probe");
+        }
+
         void Toolchain::each_config_1(const IterationCallback1 &cb)
         {
             CHAI_MSS_BEGIN();
@@ -106,6 +155,10 @@ namespace cook { namespace chai {
 
         void Toolchain::set_primary_name_functor(const PrimaryNameFunctor & functor)
         {
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot set the primary name functor");
+            context_->notify_global_effect();
+
             const Context * context = context_;
             auto lambda = [=](const model::Recipe & recipe) -> std::filesystem::path
             {
@@ -117,6 +170,10 @@ namespace cook { namespace chai {
         
         void Toolchain::set_intermediary_name_functor(const IntermediaryNameFunctor & functor)
         {
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot set the intermediary name functor");
+            context_->notify_global_effect();
+
             auto lambda = [=](const std::filesystem::path & path, const LanguageTypePair & src, const LanguageTypePair & dst, ElementType type)
             {
                 auto flags_src = Flags(src.language) | src.type;
@@ -129,6 +186,10 @@ namespace cook { namespace chai {
         
         void Toolchain::set_command_configuration_functor(const CommandConfigurationFunctor & functor)
         {
+            CHAI_MSS_BEGIN();
+            CHAI_MSS_MSG(!is_frozen(), Error, "The toolchain is frozen, cannot set the command configuration functor");
+            context_->notify_global_effect();
+
             const Context * ctx = context_;
             auto lambda = [ctx,functor](process::toolchain::Element::Ptr element, model::Recipe * recipe)
             {
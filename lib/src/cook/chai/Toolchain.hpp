@@ -31,6 +31,10 @@ namespace cook { namespace chai {
         void add_config_1(const std::string & key);
         void add_config_2(const std::string & key, const std::string & value);
         void configure(unsigned int priority, const std::string & uuid, ConfigurationCallback cb);
+        //Installs the native configuration callbacks of a built-in toolchain: standard, gcc, clang or msvc
+        void configure_native(const std::string & name);
+        //The capabilities of a compiler, only probed when they are not cached yet
+        process::toolchain::Probe & probe(const std::string & compiler);
 
         using IterationCallback1 = std::function<void (const std::string &key, const std::string &value)>;
         void each_config_1(const IterationCallback1 &);
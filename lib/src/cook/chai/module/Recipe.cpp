@@ -138,6 +138,10 @@ namespace cook { namespace chai { namespace module {
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const Flags & f) { r.define(k, f); }), "define");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const std::string & v) { r.define(k, v); }), "define");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const std::string & v, const Flags & f) { r.define(k, v, f); }), "define");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & k) { r.toolchain_option(k); }), "toolchain_option");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const Flags & f) { r.toolchain_option(k, f); }), "toolchain_option");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const std::string & v) { r.toolchain_option(k, v); }), "toolchain_option");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const std::string & v, const Flags & f) { r.toolchain_option(k, v, f); }), "toolchain_option");
         
         ptr->add(chaiscript::fun(&Recipe::run), "run");
       
@@ -154,6 +158,8 @@ namespace cook { namespace chai { namespace module {
 
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & d, const std::string & v) { return r.add_file(d, v); }), "add_file");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & d, const std::string & v, const Flags & f) { return r.add_file(d, v,f ); }), "add_file");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & d, const std::string & v) { return r.add_output(d, v); }), "add_output");
+        ptr->add(chaiscript::fun([](Recipe & r, const std::string & d, const std::string & v, const Flags & f) { return r.add_output(d, v, f); }), "add_output");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k) { return r.add_key_value(k); }), "add_key_value");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const Flags & f) { return r.add_key_value(k, f); }), "add_key_value");
         ptr->add(chaiscript::fun([](Recipe & r, const std::string & k, const std::string & v) { return r.add_key_value(k, v); }), "add_key_value");
@@ -22,6 +22,15 @@ namespace cook { namespace chai { namespace module {
         ptr->add(chaiscript::fun(&Toolchain::add_config_1), "add_config");
         ptr->add(chaiscript::fun(&Toolchain::add_config_2), "add_config");
         ptr->add(chaiscript::fun(&Toolchain::configure), "configure");
+        ptr->add(chaiscript::fun(&Toolchain::configure_native), "configure_native");
+
+        using Probe = process::toolchain::Probe;
+        ptr->add(chaiscript::user_type<Probe>(), "Probe");
+        ptr->add(chaiscript::fun(&Toolchain::probe), "probe");
+        ptr->add(chaiscript::fun(&Probe::version), "version");
+        ptr->add(chaiscript::fun(&Probe::target), "target");
+        ptr->add(chaiscript::fun(&Probe::has_flag), "has_flag");
+        ptr->add(chaiscript::fun(&Probe::has_linker), "has_linker");
         ptr->add(chaiscript::fun(&Toolchain::each_config_1), "each_config");
         ptr->add(chaiscript::fun(&Toolchain::each_config_2), "each_config");
 
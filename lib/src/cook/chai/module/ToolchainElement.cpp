@@ -47,8 +47,10 @@ namespace cook { namespace chai { namespace module {
         EXPOSE_VALUE(Part, DepFile);
         EXPOSE_VALUE(Part, Option);
         EXPOSE_VALUE(Part, Define);
+        EXPOSE_VALUE(Part, HeaderMap);
         EXPOSE_VALUE(Part, IncludePath);
         EXPOSE_VALUE(Part, ForceInclude);
+        EXPOSE_VALUE(Part, ModuleMap);
         EXPOSE_VALUE(Part, Library);
         EXPOSE_VALUE(Part, LibraryPath);
         EXPOSE_VALUE(Part, Framework);
@@ -59,6 +61,7 @@ namespace cook { namespace chai { namespace module {
         EXPOSE_VALUE(ElementType, Compile);
         EXPOSE_VALUE(ElementType, Link);
         EXPOSE_VALUE(ElementType, Archive);
+        EXPOSE_VALUE(ElementType, Scan);
 
         // the key values
         ptr->add(chaiscript::user_type<KeyValues>(), "KeyValues");
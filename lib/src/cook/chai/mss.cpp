@@ -4,7 +4,7 @@ namespace {
 
 static cook::Logger *& meyers_logger()
 {
-    static cook::Logger * logger_ = nullptr;
+    static thread_local cook::Logger * logger_ = nullptr;
     return logger_;
 }
 
@@ -15,9 +15,14 @@ namespace cook { namespace chai {
 Logger * log(const Result & rc)
 {
     auto ptr = meyers_logger();
-    ptr->log(rc);
+    if (ptr)
+        ptr->log(rc);
     return ptr;
 }
+Logger * get_logger()
+{
+    return meyers_logger();
+}
 void set_logger(Logger * logger)
 {
     meyers_logger() = logger;
@@ -8,6 +8,8 @@
 namespace cook { namespace chai {
 
 cook::Logger * log(const Result & rc);
+//The logger is per thread: isolated scripts are evaluated concurrently, each with the logger of its own context
+cook::Logger * get_logger();
 void set_logger(cook::Logger * logger);
 
 } }
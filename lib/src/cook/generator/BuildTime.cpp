@@ -0,0 +1,112 @@
+#include "cook/generator/BuildTime.hpp"
+#include "cook/process/analysis/BuildTime.hpp"
+#include "cook/Context.hpp"
+#include "cook/log/Scope.hpp"
+#include <unordered_map>
+
+namespace cook { namespace generator { 
+
+    Result BuildTime::set_option(const std::string & option)
+    {
+        MSS_BEGIN(Result);
+        set_filename(option);
+        MSS_END();
+    }
+
+    bool BuildTime::can_process(const Context & context) const
+    {
+        return context.menu().is_valid();
+    }
+
+    Result BuildTime::find_ninja_log_(std::filesystem::path & fn, const Context & context) const
+    {
+        MSS_BEGIN(Result);
+
+        //Ninja writes its log in the directory it is run from, which is typically next to build.ninja
+        for (const auto & dir: {context.dirs().output(), std::filesystem::current_path()})
+        {
+            fn = dir / ".ninja_log";
+            if (std::filesystem::exists(fn))
+                MSS_RETURN_OK();
+        }
+
+        MSG_MSS(false, Error, "Could not find .ninja_log in '" << context.dirs().output().string() << "' or the current directory, run ninja before generating the build time analysis");
+
+        MSS_END();
+    }
+
+    Result BuildTime::process(const Context & context)
+    {
+        MSS_BEGIN(Result);
+        auto ss = log::scope("process");
+
+        std::filesystem::path log_fn;
+        MSS(find_ninja_log_(log_fn, context));
+        process::analysis::NinjaLog ninja_log;
+        MSS(process::analysis::read(ninja_log, log_fn));
+
+        process::analysis::BuildTime build_time;
+
+        //Each build statement becomes a job, its dependencies are found via the files it consumes
+        struct Inputs
+        {
+            process::analysis::BuildTime::JobId id;
+            std::list<std::filesystem::path> files;
+        };
+        std::list<Inputs> inputs_per_job;
+        std::unordered_map<std::string, process::analysis::BuildTime::JobId> producer_per_file;
+
+        for (auto recipe: context.menu().topological_order_recipes())
+        {
+            auto build_graph_ptr = context.menu().recipe_filtered_graph(recipe);
+            MSS(!!build_graph_ptr);
+            const auto & build_graph = *build_graph_ptr;
+
+            process::RecipeFilteredGraph::OrderedVertices commands;
+            MSS(build_graph.topological_commands(commands));
+
+            for (auto vertex: commands)
+            {
+                auto command_ptr = std::get_if<process::build::Graph::CommandLabel>(&build_graph[vertex]);
+                MSS(!!command_ptr);
+
+                std::list<std::filesystem::path> outputs;
+                build_graph.output([&](const auto & v) { outputs.push_back(std::get<process::build::config::Graph::FileLabel>(build_graph[v])); }, vertex);
+
+                Inputs inputs;
+                inputs.id = build_time.add_job((*command_ptr)->recipe_uri(), outputs);
+                build_graph.input([&](const auto & v) { inputs.files.push_back(std::get<process::build::config::Graph::FileLabel>(build_graph[v])); }, vertex);
+                inputs_per_job.push_back(inputs);
+
+                for (const auto & output: outputs)
+                    producer_per_file[process::analysis::normalize(output)] = inputs.id;
+            }
+        }
+
+        for (const auto & inputs: inputs_per_job)
+            for (const auto & file: inputs.files)
+            {
+                auto it = producer_per_file.find(process::analysis::normalize(file));
+                if (it != producer_per_file.end())
+                    build_time.add_dependency(inputs.id, it->second);
+            }
+
+        MSS(build_time.analyse(ninja_log));
+
+        {
+            std::ofstream ofs;
+            MSS(open_output_stream(context, ofs));
+            build_time.stream_summary(ofs);
+        }
+        {
+            auto report_fn = output_filename(context.dirs());
+            report_fn.replace_extension(".json");
+            std::ofstream ofs;
+            MSS(util::open_file(report_fn, ofs));
+            build_time.stream_report(ofs);
+        }
+
+        MSS_END();
+    }
+
+} } 
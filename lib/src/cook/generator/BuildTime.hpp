@@ -0,0 +1,27 @@
+#ifndef HEADER_cook_generator_BuildTime_hpp_ALREADY_INCLUDED
+#define HEADER_cook_generator_BuildTime_hpp_ALREADY_INCLUDED
+
+#include "cook/generator/Interface.hpp"
+
+namespace cook { namespace generator { 
+
+    //Joins the timings from the .ninja_log of a previous build with the build graph:
+    //writes a text summary and a json report with the critical path, the cost per recipe and the parallelism profile
+    class BuildTime: public Interface
+    {
+    public:
+        //Interface implementation
+        std::string name() const override {return "build_time";}
+        Result set_option(const std::string & option) override;
+        bool can_process(const Context & context) const override;
+        Result process(const Context & context) override;
+        bool is_read_only() const override {return true;}
+
+    private:
+        std::string default_filename() const override {return "build_time.txt";}
+        Result find_ninja_log_(std::filesystem::path & fn, const Context & context) const;
+    };
+
+} } 
+
+#endif
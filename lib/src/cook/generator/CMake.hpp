@@ -42,6 +42,7 @@ public:
 
     bool can_process(const Context & context) const override;
     Result process(const Context & context) override;
+    bool is_read_only() const override { return true; }
 
 private:
     Result check_types_(const Context & context);
@@ -21,6 +21,9 @@ public:
     virtual bool can_process(const Context & context) const = 0;
     virtual Result process(const Context & context) = 0;
 
+    //A read-only generator only reads the context and writes its own output, it can run concurrently with the other read-only generators
+    virtual bool is_read_only() const { return false; }
+
     virtual std::filesystem::path output_filename(const model::Dirs & dirs) const
     {
         const std::string default_name = default_filename();
@@ -1,8 +1,13 @@
 #include "cook/generator/Ninja.hpp"
+#include "cook/generator/NinjaPools.hpp"
+#include "cook/generator/NinjaRegeneration.hpp"
+#include "cook/process/toolchain/Manager.hpp"
 #include "cook/process/toolchain/Types.hpp"
 #include "cook/Context.hpp"
 #include "cook/log/Scope.hpp"
 #include "cook/OS.hpp"
+#include <set>
+#include <sstream>
 
 namespace cook { namespace generator { 
 
@@ -91,6 +96,31 @@ namespace cook { namespace generator {
 
         std::unique_ptr<std::ofstream> response_file;
 
+        NinjaPools pools(physical_memory());
+        {
+            //An explicitly configured link pool depth takes precedence over the LTO jobs
+            if (context.toolchain().has_config("lto"))
+                for (const auto & jobs: context.toolchain().config_values("lto.jobs"))
+                    MSS(pools.set_link_jobs(jobs));
+            const std::string prefix = "ninja.pool.";
+            for (const auto & p: context.toolchain().all_config_values())
+                if (p.first.compare(0, prefix.size(), prefix) == 0)
+                    MSS(pools.set_depth(p.first.substr(prefix.size()), p.second));
+        }
+        pools.stream(ofs);
+
+        NinjaRegeneration regeneration(output_filename(context.dirs()), context.dirs().temporary(true), context.dirs().output(true));
+        for (const auto & script: context.scripts())
+            regeneration.add_script(script);
+        //Profiles that appear after the generation only become inputs of their compiles when cook runs again
+        if (context.toolchain().has_config("pgo", "use"))
+            for (const auto & dir: context.toolchain().config_values("pgo.dir"))
+            {
+                std::error_code ec;
+                std::filesystem::create_directories(dir, ec);
+                regeneration.add_input_dir(dir);
+            }
+
         std::map<std::string, unsigned int> uri_count_map;
         std::map<cook::process::command::Ptr, std::string> command_map;
         auto goc_command = [&](cook::process::command::Ptr ptr, const std::string & uri, std::string & cmd_name)
@@ -175,6 +205,8 @@ namespace cook { namespace generator {
             }
 
             stream_command(ofs, ptr);
+            if (ptr->restat())
+                ofs << "   restat = 1" << std::endl;
 
             // add to them map
             if (add_to_map)
@@ -187,6 +219,22 @@ namespace cook { namespace generator {
         {
             recipe->stream();
 
+            for (const auto & globber: recipe->globbings())
+            {
+                std::filesystem::path root = globber.dir;
+                if (root.is_relative())
+                    root = recipe->working_directory() / root;
+                regeneration.add_glob_root(root);
+            }
+
+            //A recipe can move its compile commands into a dedicated pool via the "ninja.pool" key-value
+            std::string recipe_pool;
+            recipe->each_key_value(LanguageTypePair(Language::Undefined, Type::Undefined), [&](const ingredient::KeyValue & kv) {
+                if (kv.owner() == recipe && kv.key() == "ninja.pool" && kv.has_value())
+                    recipe_pool = kv.value();
+                return true;
+            });
+
             auto build_graph_ptr = context.menu().recipe_filtered_graph(recipe);
             L(C(build_graph_ptr));
             MSS(!!build_graph_ptr);
@@ -236,13 +284,27 @@ namespace cook { namespace generator {
                                          });
                 }
 
+                std::list<std::filesystem::path> order_only_dependencies;
+                {
+                    auto func = [&](const auto & v)
+                    {
+                        order_only_dependencies.push_back(std::get<process::build::config::Graph::FileLabel>(build_graph[v]));
+                    };
+                    build_graph.input(func, vertex, cook::process::RecipeFilteredGraph::OrderOnly);
+
+                    auto ss = log::scope("order-only inputs", [&](auto & n) {
+                                         for (const auto & f: order_only_dependencies)
+                                         n.attr("file", f);
+                                         });
+                }
+
                 std::list<std::filesystem::path> output_files;
                 {
                     auto func = [&](const auto & v)
                     {
                         output_files.push_back(std::get<process::build::config::Graph::FileLabel>(build_graph[v]));
                     };
-                    build_graph.output(func, vertex);
+                    build_graph.output(func, vertex, cook::process::RecipeFilteredGraph::Explicit);
 
                     auto ss = log::scope("outputs", [&](auto & n) {
                                          for (const auto & f: output_files)
@@ -250,6 +312,25 @@ namespace cook { namespace generator {
                                          });
                 }
 
+                std::list<std::filesystem::path> implicit_output_files;
+                {
+                    auto func = [&](const auto & v)
+                    {
+                        implicit_output_files.push_back(std::get<process::build::config::Graph::FileLabel>(build_graph[v]));
+                    };
+                    build_graph.output(func, vertex, cook::process::RecipeFilteredGraph::Implicit);
+
+                    auto ss = log::scope("implicit outputs", [&](auto & n) {
+                                         for (const auto & f: implicit_output_files)
+                                         n.attr("file", f);
+                                         });
+                }
+
+                for (const auto & f: output_files)
+                    regeneration.add_output(f);
+                for (const auto & f: implicit_output_files)
+                    regeneration.add_output(f);
+
                 std::string build_command;
                 MSS(goc_command(command, recipe->uri().string(false, '_'), build_command));
                 //The build basically specifies the dependency between the output and input files
@@ -262,6 +343,15 @@ namespace cook { namespace generator {
                     ofs << " ";
                     stream_escaped(f.string());
                 }
+                if (!implicit_output_files.empty())
+                {
+                    ofs << " |";
+                    for (const auto & f: implicit_output_files)
+                    {
+                        ofs << " ";
+                        stream_escaped(f.string());
+                    }
+                }
                 ofs << ": ";
                 stream_escaped(build_command);
                 //Emile: This is a workaround for 1 specific problem on windows:
@@ -284,9 +374,36 @@ namespace cook { namespace generator {
                     ofs << " ";
                     stream_escaped(f.string());
                 }
+                if (!order_only_dependencies.empty())
+                {
+                    ofs << " ||";
+                    for (const auto & f: order_only_dependencies)
+                    {
+                        ofs << " ";
+                        stream_escaped(f.string());
+                    }
+                }
                 ofs << std::endl;
+                //The dyndep file completes the dependencies once it is generated, it has to be an input of this build statement
+                if (!command->dyndep().empty())
+                {
+                    ofs << "   dyndep = ";
+                    stream_escaped(command->dyndep().string());
+                    ofs << std::endl;
+                }
+                {
+                    std::string pool;
+                    MSS(pools.pool(pool, command->type(), recipe_pool));
+                    if (!pool.empty())
+                        ofs << "   pool = " << pool << std::endl;
+                }
             }
         }
+
+        //Ninja reruns cook with the same arguments when a script or a globbed directory is newer than the manifest
+        if (!context.executable().empty())
+            regeneration.stream(ofs, context.executable(), context.arguments(), context.working_directory());
+
         MSS_END();
     }
 
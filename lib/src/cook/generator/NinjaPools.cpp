@@ -0,0 +1,132 @@
+#include "cook/generator/NinjaPools.hpp"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace cook { namespace generator { 
+
+    namespace {
+
+        const std::uint64_t GiB = std::uint64_t(1) << 30;
+
+        //Rough memory usage of a single command
+        const std::uint64_t memory_per_link = 4*GiB;
+        const std::uint64_t memory_per_archive = 1*GiB;
+        const std::uint64_t memory_per_heavy = 2*GiB;
+
+        unsigned int depth_for(std::uint64_t memory, std::uint64_t memory_per_command)
+        {
+            //Without memory information, only ninja's -j bounds the commands
+            if (memory == 0)
+                return std::max(1u, std::thread::hardware_concurrency());
+            return static_cast<unsigned int>(std::max<std::uint64_t>(1, memory/memory_per_command));
+        }
+
+        bool is_valid_name(const std::string & name)
+        {
+            return !name.empty() && std::all_of(name.begin(), name.end(), [](char ch) {
+                return ('a' <= ch && ch <= 'z') || ('A' <= ch && ch <= 'Z') || ('0' <= ch && ch <= '9') || ch == '_' || ch == '-';
+            });
+        }
+
+        //Only plain decimal numbers that fit an unsigned int
+        bool parse_unsigned(unsigned int & value, const std::string & str)
+        {
+            if (str.empty())
+                return false;
+            std::uint64_t v = 0;
+            for (const auto ch: str)
+            {
+                if (ch < '0' || '9' < ch)
+                    return false;
+                v = 10*v + (ch - '0');
+                if (v > std::numeric_limits<unsigned int>::max())
+                    return false;
+            }
+            value = static_cast<unsigned int>(v);
+            return true;
+        }
+
+    }
+
+    NinjaPools::NinjaPools(std::uint64_t memory)
+    {
+        depth_per_pool_["link"] = depth_for(memory, memory_per_link);
+        depth_per_pool_["archive"] = depth_for(memory, memory_per_archive);
+        depth_per_pool_["heavy"] = depth_for(memory, memory_per_heavy);
+    }
+
+    Result NinjaPools::set_depth(const std::string & name, const std::string & depth)
+    {
+        MSS_BEGIN(Result);
+
+        MSG_MSS(is_valid_name(name), Error, "Invalid ninja pool name '" << name << "'");
+        MSG_MSS(name != "console", Error, "The depth of the ninja console pool cannot be changed");
+        unsigned int value;
+        MSG_MSS(parse_unsigned(value, depth), Error, "Invalid depth '" << depth << "' for ninja pool '" << name << "'");
+
+        depth_per_pool_[name] = value;
+
+        MSS_END();
+    }
+
+    Result NinjaPools::set_link_jobs(const std::string & jobs)
+    {
+        MSS_BEGIN(Result);
+
+        unsigned int nr_jobs;
+        MSG_MSS(parse_unsigned(nr_jobs, jobs), Error, "Invalid number of LTO jobs '" << jobs << "'");
+        nr_jobs = std::max(1u, nr_jobs);
+        const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+        auto & depth = depth_per_pool_["link"];
+        depth = std::max(1u, std::min(depth, cores/nr_jobs));
+
+        MSS_END();
+    }
+
+    Result NinjaPools::pool(std::string & name, process::command::Interface::Type type, const std::string & recipe_pool) const
+    {
+        MSS_BEGIN(Result);
+
+        name.clear();
+        switch (type)
+        {
+            case process::command::Interface::Link:     name = "link"; break;
+            case process::command::Interface::Archive:  name = "archive"; break;
+            case process::command::Interface::Compile:
+            case process::command::Interface::Script:   name = recipe_pool; break;
+            default: break;
+        }
+
+        if (name == "console")
+            MSS_RETURN_OK();
+
+        if (!name.empty())
+        {
+            auto it = depth_per_pool_.find(name);
+            MSG_MSS(it != depth_per_pool_.end(), Error, "Unknown ninja pool '" << name << "', declare it via the toolchain configuration ninja.pool." << name);
+            if (it->second == 0)
+                name.clear();
+        }
+
+        MSS_END();
+    }
+
+    void NinjaPools::stream(std::ostream & os) const
+    {
+        for (const auto & p: depth_per_pool_)
+        {
+            if (p.second == 0)
+                continue;
+            os << "pool " << p.first << std::endl;
+            os << "   depth = " << p.second << std::endl;
+        }
+    }
+
+    unsigned int NinjaPools::depth(const std::string & name) const
+    {
+        auto it = depth_per_pool_.find(name);
+        return it == depth_per_pool_.end() ? 0 : it->second;
+    }
+
+} } 
@@ -0,0 +1,43 @@
+#ifndef HEADER_cook_generator_NinjaPools_hpp_ALREADY_INCLUDED
+#define HEADER_cook_generator_NinjaPools_hpp_ALREADY_INCLUDED
+
+#include "cook/process/command/Interface.hpp"
+#include "cook/Result.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <map>
+
+namespace cook { namespace generator { 
+
+    //The ninja pools that bound the number of concurrent memory-heavy commands, while compiles keep running at full width:
+    // * link: all link commands
+    // * archive: all archive commands
+    // * heavy: the compile and script commands of recipes that set the "ninja.pool" key-value to "heavy"
+    //The depth of each pool can be set via the toolchain configuration "ninja.pool.<name>=<depth>", which can also declare
+    //additional pools for recipes to use. Depth 0 does not restrict the commands.
+    class NinjaPools
+    {
+    public:
+        //The default depths are derived from the physical memory, if known
+        explicit NinjaPools(std::uint64_t memory);
+
+        Result set_depth(const std::string & name, const std::string & depth);
+
+        //Each link runs this many LTO backend jobs, the link pool is limited so that the links together do not exceed the cores
+        Result set_link_jobs(const std::string & jobs);
+
+        //The pool for a command, the recipe pool only applies to compile and script commands. An empty name means no pool.
+        Result pool(std::string & name, process::command::Interface::Type type, const std::string & recipe_pool) const;
+
+        void stream(std::ostream & os) const;
+
+        unsigned int depth(const std::string & name) const;
+
+    private:
+        std::map<std::string, unsigned int> depth_per_pool_;
+    };
+
+} } 
+
+#endif
@@ -0,0 +1,175 @@
+#include "cook/generator/NinjaRegeneration.hpp"
+#include "cook/OS.hpp"
+#include <sstream>
+
+namespace cook { namespace generator { 
+
+    namespace {
+
+        std::filesystem::path normalized(const std::filesystem::path & path)
+        {
+            std::error_code ec;
+            auto res = std::filesystem::weakly_canonical(path, ec);
+            if (ec)
+                res = std::filesystem::absolute(path).lexically_normal();
+            if (!res.has_filename())
+                res = res.parent_path();
+            return res;
+        }
+
+        bool is_within(const std::filesystem::path & path, const std::filesystem::path & dir)
+        {
+            auto it = path.begin();
+            for (const auto & part: dir)
+            {
+                if (it == path.end() || *it != part)
+                    return false;
+                ++it;
+            }
+            return true;
+        }
+
+        std::string escape_path(const std::string & str)
+        {
+            std::string res;
+            for (const auto ch: str)
+            {
+                if (ch == '$' || ch == ':' || ch == ' ')
+                    res += '$';
+                res += ch;
+            }
+            return res;
+        }
+
+    }
+
+    NinjaRegeneration::NinjaRegeneration(const std::filesystem::path & manifest, const std::filesystem::path & temporary_dir, const std::filesystem::path & output_dir)
+        : manifest_(manifest),
+          temporary_dir_(normalized(temporary_dir)),
+          output_dir_(normalized(output_dir))
+    {
+        //Ninja keeps its log and dependencies next to the manifest
+        add_output(manifest);
+    }
+
+    void NinjaRegeneration::add_script(const std::filesystem::path & fn)
+    {
+        scripts_.insert(fn);
+    }
+
+    void NinjaRegeneration::add_glob_root(const std::filesystem::path & dir)
+    {
+        glob_roots_.insert(normalized(dir));
+    }
+
+    void NinjaRegeneration::add_input_dir(const std::filesystem::path & dir)
+    {
+        input_dirs_.insert(normalized(dir));
+    }
+
+    void NinjaRegeneration::add_output(const std::filesystem::path & fn)
+    {
+        written_dirs_.insert(normalized(fn).parent_path());
+    }
+
+    bool NinjaRegeneration::is_excluded_(const std::filesystem::path & dir, bool skip_output) const
+    {
+        return is_within(dir, temporary_dir_) || (skip_output && is_within(dir, output_dir_));
+    }
+
+    std::set<std::filesystem::path> NinjaRegeneration::inputs() const
+    {
+        std::set<std::filesystem::path> inputs = scripts_;
+
+        auto add_dir = [&](const std::filesystem::path & dir)
+        {
+            if (written_dirs_.count(dir) == 0)
+                inputs.insert(dir);
+        };
+
+        for (const auto & root: glob_roots_)
+        {
+            std::error_code ec;
+            if (!std::filesystem::is_directory(root, ec))
+                continue;
+
+            //An output directory that contains the sources is walked, one inside them is not
+            const bool skip_output = !is_within(root, output_dir_);
+            if (is_excluded_(root, skip_output))
+                continue;
+
+            add_dir(root);
+            for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec))
+            {
+                std::error_code dir_ec;
+                if (!it->is_directory(dir_ec))
+                    continue;
+                if (is_excluded_(it->path(), skip_output))
+                {
+                    it.disable_recursion_pending();
+                    continue;
+                }
+                add_dir(it->path());
+            }
+        }
+
+        for (const auto & root: input_dirs_)
+        {
+            std::error_code ec;
+            if (!std::filesystem::is_directory(root, ec))
+                continue;
+
+            add_dir(root);
+            for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec))
+            {
+                std::error_code dir_ec;
+                if (it->is_directory(dir_ec))
+                    add_dir(it->path());
+            }
+        }
+
+        return inputs;
+    }
+
+    void NinjaRegeneration::stream(std::ostream & os, const std::filesystem::path & executable, const std::list<std::string> & arguments, const std::filesystem::path & working_directory) const
+    {
+        std::ostringstream cmd;
+        cmd << quote_argument(executable.string());
+        for (const auto & arg: arguments)
+            cmd << ' ' << quote_argument(arg);
+
+        const std::string wd = quote_argument(working_directory.empty() ? std::filesystem::current_path().string() : working_directory.string());
+
+        os << std::endl;
+        os << "rule cook" << std::endl;
+        if (get_os() == OS::Windows)
+            os << "   command = cmd /c \"cd /d " << wd << " && " << cmd.str() << "\"" << std::endl;
+        else
+            os << "   command = cd " << wd << " && " << cmd.str() << std::endl;
+        os << "   description = Regenerating ${out}" << std::endl;
+        os << "   generator = 1" << std::endl;
+        os << "   restat = 1" << std::endl;
+
+        os << "build " << escape_path(manifest_.string()) << ": cook |";
+        for (const auto & input: inputs())
+            os << " " << escape_path(input.string());
+        os << std::endl;
+    }
+
+    std::string NinjaRegeneration::quote_argument(const std::string & str)
+    {
+        std::string res;
+        for (const auto ch: str)
+        {
+            if (ch == '$')
+                res += '$';
+            else if (ch == '"')
+                res += '\\';
+            res += ch;
+        }
+        if (res.empty() || res.find_first_of(" \t\"'&;|<>()") != std::string::npos)
+            res = "\"" + res + "\"";
+        return res;
+    }
+
+} } 
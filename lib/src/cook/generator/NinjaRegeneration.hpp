@@ -0,0 +1,54 @@
+#ifndef HEADER_cook_generator_NinjaRegeneration_hpp_ALREADY_INCLUDED
+#define HEADER_cook_generator_NinjaRegeneration_hpp_ALREADY_INCLUDED
+
+#include "gubg/std/filesystem.hpp"
+#include <ostream>
+#include <string>
+#include <list>
+#include <set>
+
+namespace cook { namespace generator { 
+
+    //The build statement that reruns cook before the build when one of its inputs is newer than the ninja manifest:
+    // * the scripts the recipes and toolchain were loaded from
+    // * every directory a glob walks: adding or removing a file changes the modification time of its directory
+    // * the directories with files that influence the build statements when they appear, eg the PGO profiles
+    //The build changes the directories it writes into, which would regenerate the manifest after every build:
+    // * the temporary directory, and an output directory inside the globbed sources, are not walked
+    // * the directories that receive build outputs or the files of ninja itself (.ninja_log, .ninja_deps next to
+    //   the manifest) are walked, but are no input. Files added directly into these need an explicit rerun of cook.
+    class NinjaRegeneration
+    {
+    public:
+        NinjaRegeneration(const std::filesystem::path & manifest, const std::filesystem::path & temporary_dir, const std::filesystem::path & output_dir);
+
+        void add_script(const std::filesystem::path & fn);
+        void add_glob_root(const std::filesystem::path & dir);
+        //The directory and its subdirectories are inputs, also when they are in the temporary or output directory
+        void add_input_dir(const std::filesystem::path & dir);
+        //A file that the build creates
+        void add_output(const std::filesystem::path & fn);
+
+        std::set<std::filesystem::path> inputs() const;
+
+        //Reruns executable with arguments from working_directory
+        void stream(std::ostream & os, const std::filesystem::path & executable, const std::list<std::string> & arguments, const std::filesystem::path & working_directory) const;
+
+        //Quoted for the shell when needed, with the $ escaped for ninja
+        static std::string quote_argument(const std::string & str);
+
+    private:
+        bool is_excluded_(const std::filesystem::path & dir, bool skip_output) const;
+
+        std::filesystem::path manifest_;
+        std::filesystem::path temporary_dir_;
+        std::filesystem::path output_dir_;
+        std::set<std::filesystem::path> scripts_;
+        std::set<std::filesystem::path> glob_roots_;
+        std::set<std::filesystem::path> input_dirs_;
+        std::set<std::filesystem::path> written_dirs_;
+    };
+
+} } 
+
+#endif
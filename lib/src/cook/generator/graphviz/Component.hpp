@@ -14,6 +14,7 @@ public:
 
     bool can_process(const Context & context) const override;
     Result process(const Context & context) override;
+    bool is_read_only() const override { return true; }
 
     std::string default_filename() const override;
 
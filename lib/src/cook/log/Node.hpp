@@ -14,14 +14,21 @@ namespace cook { namespace log {
     class Node: public std::enable_shared_from_this<Node>
     {
     public:
+        //Each thread has its own stack of scopes
         static Ptr &top_ptr()
         {
-            static Ptr ptr;
+            static thread_local Ptr ptr;
             if (!ptr)
                 ptr.reset(new Node);
             return ptr;
         }
         static Node &top() {return *top_ptr();}
+        //The importance of the innermost scope, also when that scope is filtered out and has no node
+        static int &top_importance()
+        {
+            static thread_local int importance = 0;
+            return importance;
+        }
 
         Ptr add(const std::string &header, Importance importance = Importance{})
         {
@@ -45,7 +52,7 @@ namespace cook { namespace log {
 
     inline int importance(Importance imp)
     {
-        return imp.value_or(Node::top().importance());
+        return imp.value_or(Node::top_importance());
     }
 
 } } 
@@ -1,45 +1,74 @@
 #include "cook/log/Scope.hpp"
+#include <mutex>
 
 namespace cook { namespace log { 
 
-    Scope::Scope(const Ptr &node): node_(node), do_log_(log::do_log(node_->importance()))
+    namespace  { 
+        std::mutex &output_mutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+    } 
+
+    namespace details { 
+        std::ostringstream &header_stream()
+        {
+            static thread_local std::ostringstream oss;
+            return oss;
+        }
+    } 
+
+    Scope::Scope(const Ptr &node): node_(node), previous_importance_(Node::top_importance()), do_log_(log::do_log(node_->importance()))
     {
         if (do_log_)
+        {
+            std::lock_guard<std::mutex> lock(output_mutex());
             indent_(std::cout, true) << node_->header();
+        }
         Node::top_ptr() = node_;
+        Node::top_importance() = node_->importance();
     }
-    Scope::Scope(Scope &&dying): do_log_(dying.do_log_)
+    Scope::Scope(int importance): previous_importance_(Node::top_importance())
+    {
+        Node::top_importance() = importance;
+    }
+    Scope::Scope(Scope &&dying): previous_importance_(dying.previous_importance_), do_log_(dying.do_log_), is_alive_(dying.is_alive_)
     {
         std::swap(node_, dying.node_);
+        dying.is_alive_ = false;
     }
     Scope::~Scope()
     {
-        if (!node_)
+        if (!is_alive_)
             //Dying
             return;
+
+        Node::top_importance() = previous_importance_;
+        if (!node_)
+            //Filtered out
+            return;
+
         if (do_log_)
+        {
+            std::lock_guard<std::mutex> lock(output_mutex());
             indent_(std::cout, false);
+        }
 
         Node::top_ptr() = node_->parent();
     }
 
     std::ostream &Scope::indent_(std::ostream &os, bool increase)
     {
-        static unsigned int level = 0;
-        static bool is_open = true;
-
-
-
-        static std::string str;
+        static thread_local unsigned int level = 0;
+        static thread_local bool is_open = true;
+        static thread_local std::string str;
         if (increase)
         {
             str.resize(level*2, ' ');
-            if (level >= 0)
-            {
-                if (is_open)
-                    os << "{";
-                os << std::endl << str;
-            }
+            if (is_open)
+                os << "{";
+            os << std::endl << str;
             is_open = true;
             ++level;
         }
@@ -61,12 +90,16 @@ namespace cook { namespace log {
 
     Scope scope(const std::string &tag, Importance importance)
     {
-        static std::ostringstream oss;
+        const int imp = log::importance(importance);
+        if (!do_log(imp))
+            return Scope{imp};
+
+        auto &oss = details::header_stream();
         oss.str("");
         details::Header header(oss);
         header.tag(tag);
-        return Scope{Node::top().add(oss.str(), importance)};
+        return Scope{Node::top().add(oss.str(), imp)};
     }
     Scope scope(const std::string &tag) { return scope(tag, Importance{}); }
 
-} } 
+} }
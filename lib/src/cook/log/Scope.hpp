@@ -33,10 +33,13 @@ namespace cook { namespace log {
         };
     } 
 
+    //Scopes that are filtered out by the log level only track their importance: they create no node
+    //and their attributes are not formatted
     class Scope
     {
     public:
         Scope(const Ptr &node);
+        explicit Scope(int importance);
         Scope(Scope &&dying);
         ~Scope();
 
@@ -47,10 +50,15 @@ namespace cook { namespace log {
         static std::ostream &indent_(std::ostream &os, bool increase);
 
         Ptr node_;
+        int previous_importance_ = 0;
         bool do_log_ = false;
-        bool is_open_ = true;
+        bool is_alive_ = true;
     };
 
+    namespace details { 
+        std::ostringstream &header_stream();
+    } 
+
     Scope scope(const std::string &tag, Importance importance);
     Scope scope(const std::string &tag, unsigned int importance);
     Scope scope(const std::string &tag);
@@ -58,12 +66,16 @@ namespace cook { namespace log {
     template <typename Ftor>
     Scope scope(const std::string &tag, Importance importance, Ftor &&ftor)
     {
-        static std::ostringstream oss;
+        const int imp = log::importance(importance);
+        if (!do_log(imp))
+            return Scope{imp};
+
+        auto &oss = details::header_stream();
         oss.str("");
         details::Header header(oss);
         header.tag(tag);
         ftor(header);
-        return Scope{Node::top().add(oss.str(), importance)};
+        return Scope{Node::top().add(oss.str(), imp)};
     }
     template <typename Ftor>
     Scope scope(const std::string &tag, Ftor &&ftor, std::invoke_result_t<Ftor, details::Header &> * /*dummy*/ = nullptr) { return scope(tag, Importance{}, ftor); }
@@ -28,6 +28,40 @@ gubg::Range<Book::RecipeIterator> Book::recipes() const
     return gubg::iterator::transform<ExtractPointer>(gubg::make_range(recipes_));
 }
 
+Result Book::merge(Book & source)
+{
+    MSS_BEGIN(Result);
+
+    MSG_MSS(source.uri() == uri(), InternalError, "Cannot merge book " << source.uri() << " into " << uri());
+
+    for(const auto & p : source.recipes_)
+        MSG_MSS(recipes_.find(p.first) == recipes_.end(), Error, "Recipe " << p.second->uri() << " is defined in multiple libraries");
+
+    for(auto & p : source.recipes_)
+    {
+        MSS(p.second->set_parent(this));
+        recipes_.insert(p);
+    }
+    source.recipes_.clear();
+
+    for(auto & p : source.subbooks_)
+    {
+        auto it = subbooks_.find(p.first);
+        if (it == subbooks_.end())
+        {
+            MSS(p.second->set_parent(this));
+            subbooks_.insert(p);
+        }
+        else
+        {
+            MSS(it->second->merge(*p.second));
+        }
+    }
+    source.subbooks_.clear();
+
+    MSS_END();
+}
+
 Book * Book::find_book_(const Part & part) const
 {
     auto it = subbooks_.find(part);
@@ -36,6 +36,9 @@ public:
 
     bool is_root() const;
 
+    //Moves the books and recipes of source, a book with the same uri from another library, into this book
+    Result merge(Book & source);
+
     gubg::Range<BookIterator> books() const;
     gubg::Range<RecipeIterator> recipes() const;
 
@@ -6,7 +6,7 @@
 
 namespace cook { namespace model {
 
-struct Book;
+class Book;
 
 class Element
 {
@@ -23,6 +23,7 @@ public:
     std::string name() const;
 
 protected:
+    friend class Book;
     bool set_parent(Book * parent);
 
 private:
@@ -1,6 +1,7 @@
 #include "cook/model/Library.hpp"
 #include "cook/model/Recipe.hpp"
 #include <stack>
+#include <set>
 #include <cassert>
 
 namespace cook{ namespace model {
@@ -47,25 +48,39 @@ Result Library::find_first_relative_(Recipe *& recipe, const Uri & uri, Book * r
 }
 
 Result Library::resolve(bool * all_resolved) const
+{
+    return resolve(list_all_recipes(), all_resolved);
+}
+
+Result Library::resolve(const std::list<Recipe *> & roots, bool * all_resolved) const
 {
     MSS_BEGIN(Result);
 
     bool unresolved_dependency_found = false;
 
-    std::list<Recipe *> recipes = list_all_recipes();
-    for(Recipe * recipe : recipes)
+    std::set<Recipe *> visited;
+    std::stack<Recipe *> todo;
+    for(Recipe * root : roots)
+        todo.push(root);
+
+    while(!todo.empty())
     {
+        Recipe * recipe = todo.top();
+        todo.pop();
+        if (!visited.insert(recipe).second)
+            continue;
+
         for(const auto & p : recipe->dependency_pairs())
         {
             Recipe * dep = p.second.recipe;
             const Uri & uri = p.first;
             if (dep != nullptr)
+            {
+                todo.push(dep);
                 continue;
+            }
 
-            if (uri.absolute())
-                MSS(find_recipe(dep, uri));
-            else
-                MSS(find_first_relative_(dep, uri, recipe->parent()));
+            MSS(find_dependency(dep, *recipe, uri));
 
             if (dep == nullptr)
             {
@@ -75,6 +90,7 @@ Result Library::resolve(bool * all_resolved) const
             else
             {
                 MSS(recipe->resolve_dependency(uri, dep));
+                todo.push(dep);
             }
         }
     }
@@ -85,7 +101,18 @@ Result Library::resolve(bool * all_resolved) const
     MSS_END();
 }
 
+Result Library::find_dependency(Recipe *& dep, const Recipe & recipe, const Uri & uri) const
+{
+    MSS_BEGIN(Result);
 
+    dep = nullptr;
+    if (uri.absolute())
+        MSS(find_recipe(dep, uri));
+    else
+        MSS(find_first_relative_(dep, uri, recipe.parent()));
+
+    MSS_END();
+}
 
 Result Library::find_recipe(Recipe *& result, const Uri & uri, Book * relative_root) const
 {
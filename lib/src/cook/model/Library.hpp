@@ -12,6 +12,10 @@ struct Library
 
     std::list<Recipe *> list_all_recipes() const;
     Result resolve(bool * all_resolved = nullptr) const;
+    //Only resolves the dependencies within the closure of roots, the other recipes are not touched
+    Result resolve(const std::list<Recipe *> & roots, bool * all_resolved = nullptr) const;
+    //Looks up a dependency of recipe the way resolve() does, dep is nullptr when not found
+    Result find_dependency(Recipe *& dep, const Recipe & recipe, const Uri & uri) const;
 
     Result find_recipe(Recipe *& result, const Uri & uri, Book * relative_root = nullptr) const;
     Result goc_recipe(Recipe *& result, const Uri & uri, Book * relative_root = nullptr);
@@ -58,6 +58,23 @@ public:
     //Copying is needed in MESSAGE()
     Recipe(const Recipe &) = default;
 
+    //What processing changes of a recipe, to process it again from scratch for another configuration
+    struct Snapshot
+    {
+        Files files;
+        KeyValues key_values;
+        BuildTarget build_target;
+        std::set<Language> languages;
+    };
+    Snapshot snapshot() const { return Snapshot{files_, key_values_, build_target_, languages_}; }
+    void restore(const Snapshot & snapshot)
+    {
+        files_ = snapshot.files;
+        key_values_ = snapshot.key_values;
+        build_target_ = snapshot.build_target;
+        languages_ = snapshot.languages;
+    }
+
     bool insert(const LanguageTypePair & ltp, const ingredient::File & file)
     {
         return files_.insert(ltp, file.dir().is_absolute() ? file : ingredient::File(file, working_directory())).second;
@@ -97,12 +97,29 @@ Result Menu::construct_()
     MSS(algo::make_ComponentGraph(dependency_graph_.graph, component_graph_.graph, component_graph_.translation_map));
 
     // try to order the component graph topologically
-    std::vector<ComponentVertex> vertices(gubg::graph::num_vertices(component_graph().graph));
+    component_order_.assign(gubg::graph::num_vertices(component_graph().graph), ComponentVertex());
 
-    MSS(gubg::graph::construct_topological_order(component_graph().graph, vertices.rbegin()));
+    MSS(gubg::graph::construct_topological_order(component_graph().graph, component_order_.rbegin()));
+
+    construct_build_graphs_();
+
+    valid_ = true;
+
+    MSS_END();
+}
+
+void Menu::reset_build_graphs()
+{
+    construct_build_graphs_();
+}
+
+void Menu::construct_build_graphs_()
+{
+    recipe_filtered_graphs_.clear();
+    topological_build_graph_order_.clear();
 
     // process the components in topological order
-    for(ComponentVertex v : vertices)
+    for(auto v : component_order_)
     {
         // a single graph per component
         build::GraphPtr ptr = std::make_shared<build::Graph>();
@@ -115,10 +132,6 @@ Result Menu::construct_()
         // and assign the build graph order to the topological list
         topological_build_graph_order_.push_back(ptr);
     }
-
-    valid_ = true;
-
-    MSS_END();
 }
 
 
@@ -8,6 +8,7 @@
 #include "cook/Log.hpp"
 #include "gubg/graph/AdjacencyList.hpp"
 #include <unordered_map>
+#include <vector>
 
 namespace cook { namespace process {
 
@@ -44,9 +45,13 @@ public:
     const DependencyGraph & dependency_graph() const;
     const ComponentGraph & component_graph() const;
 
+    //The const lookup only reads, concurrent generators can use it
     const RecipeFilteredGraph * recipe_filtered_graph(model::Recipe *recipe) const;
     RecipeFilteredGraph * recipe_filtered_graph(model::Recipe * recipe);
 
+    //Starts again from empty build graphs, the dependency graph and topological order are kept
+    void reset_build_graphs();
+
     void stream(log::Importance = log::Importance{}) const;
 
 private:
@@ -57,12 +62,14 @@ private:
 
     using CountMap = std::unordered_map<model::Recipe *, unsigned int>;
     Result construct_();
+    void construct_build_graphs_();
 
     std::list<model::Recipe *> topological_order_;
     std::list<model::Recipe *> root_recipes_;
 
     std::map<model::Recipe *, RecipeFilteredGraph> recipe_filtered_graphs_;
     std::list<build::GraphPtr> topological_build_graph_order_;
+    std::vector<gubg::graph::Traits<ComponentGraph::Graph>::vertex_descriptor> component_order_;
     bool valid_;
 
     DependencyGraph dependency_graph_;
@@ -0,0 +1,337 @@
+#include "cook/process/analysis/BuildTime.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace cook { namespace process { namespace analysis {
+
+    namespace {
+
+        std::string seconds(unsigned long ms)
+        {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(3) << ms/1000.0;
+            return oss.str();
+        }
+
+        std::string escape_json(const std::string & str)
+        {
+            std::string res;
+            for (const auto ch: str)
+            {
+                switch (ch)
+                {
+                    case '"':  res += "\\\""; break;
+                    case '\\': res += "\\\\"; break;
+                    case '\n': res += "\\n"; break;
+                    case '\t': res += "\\t"; break;
+                    default:   res += ch; break;
+                }
+            }
+            return res;
+        }
+
+        bool split_tabs(std::vector<std::string> & fields, const std::string & line)
+        {
+            fields.clear();
+            std::istringstream iss(line);
+            std::string field;
+            while (std::getline(iss, field, '\t'))
+                fields.push_back(field);
+            return fields.size() == 5;
+        }
+
+        bool to_ulong(unsigned long & value, const std::string & str)
+        {
+            if (str.empty() || !std::all_of(str.begin(), str.end(), [](char ch) { return '0' <= ch && ch <= '9'; }))
+                return false;
+            value = std::stoul(str);
+            return true;
+        }
+
+    }
+
+    Result parse(NinjaLog & log, std::istream & is)
+    {
+        MSS_BEGIN(Result);
+
+        std::string line;
+        MSG_MSS(std::getline(is, line) && line.rfind("# ninja log v", 0) == 0, Error, "Ninja log does not start with the expected header");
+
+        std::vector<std::string> fields;
+        unsigned int run = 0;
+        unsigned long previous_end_ms = 0;
+        for (unsigned int nr = 2; std::getline(is, line); ++nr)
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty() || line.front() == '#')
+                continue;
+
+            //start_ms, end_ms, mtime, output, command hash
+            MSG_MSS(split_tabs(fields, line), Error, "Ninja log line " << nr << " does not have 5 fields");
+            LogEntry entry;
+            MSG_MSS(to_ulong(entry.start_ms, fields[0]) && to_ulong(entry.end_ms, fields[1]) && entry.start_ms <= entry.end_ms, Error, "Ninja log line " << nr << " has invalid timings");
+            if (entry.end_ms < previous_end_ms)
+                ++run;
+            previous_end_ms = entry.end_ms;
+            entry.run = run;
+
+            log[normalize(fields[3])] = entry;
+        }
+
+        MSS_END();
+    }
+
+    Result read(NinjaLog & log, const std::filesystem::path & fn)
+    {
+        MSS_BEGIN(Result);
+
+        std::ifstream fi(fn, std::ios::binary);
+        MSG_MSS(fi.good(), Error, "Could not open ninja log '" << fn.string() << "'");
+        MSS(parse(log, fi));
+
+        MSS_END();
+    }
+
+    std::string normalize(const std::filesystem::path & path)
+    {
+        return path.lexically_normal().generic_string();
+    }
+
+    BuildTime::JobId BuildTime::add_job(const std::string & recipe, const std::list<std::filesystem::path> & outputs)
+    {
+        Job job;
+        job.recipe = recipe;
+        for (const auto & output: outputs)
+            job.outputs.push_back(normalize(output));
+
+        jobs_.push_back(job);
+        return jobs_.size()-1;
+    }
+
+    void BuildTime::add_dependency(JobId consumer, JobId producer)
+    {
+        if (consumer != producer)
+            jobs_[consumer].producers.insert(producer);
+    }
+
+    unsigned long BuildTime::critical_path_ms() const
+    {
+        return critical_path_.empty() ? 0 : jobs_[critical_path_.back()].finish_ms;
+    }
+
+    Result BuildTime::topological_order_(std::vector<JobId> & order) const
+    {
+        MSS_BEGIN(Result);
+
+        std::vector<unsigned int> nr_producers(jobs_.size());
+        std::vector<std::list<JobId>> consumers(jobs_.size());
+        for (JobId id = 0; id < jobs_.size(); ++id)
+        {
+            nr_producers[id] = jobs_[id].producers.size();
+            for (auto producer: jobs_[id].producers)
+                consumers[producer].push_back(id);
+        }
+
+        order.clear();
+        for (JobId id = 0; id < jobs_.size(); ++id)
+            if (nr_producers[id] == 0)
+                order.push_back(id);
+        for (std::size_t ix = 0; ix < order.size(); ++ix)
+            for (auto consumer: consumers[order[ix]])
+                if (--nr_producers[consumer] == 0)
+                    order.push_back(consumer);
+
+        MSG_MSS(order.size() == jobs_.size(), InternalError, "The build commands contain a cycle");
+
+        MSS_END();
+    }
+
+    Result BuildTime::analyse(const NinjaLog & log)
+    {
+        MSS_BEGIN(Result);
+
+        recipe_costs_.clear();
+        critical_path_.clear();
+        cumulative_ms_ = 0;
+
+        for (auto & job: jobs_)
+        {
+            job.timed = false;
+            job.entry = LogEntry();
+            for (const auto & output: job.outputs)
+            {
+                auto it = log.find(output);
+                if (it != log.end())
+                {
+                    job.timed = true;
+                    job.entry = it->second;
+                    break;
+                }
+            }
+
+            auto & cost = recipe_costs_[job.recipe];
+            ++cost.jobs;
+            if (!job.timed)
+                ++cost.untimed;
+            cost.cumulative_ms += job.entry.duration_ms();
+            cumulative_ms_ += job.entry.duration_ms();
+        }
+
+        std::vector<JobId> order;
+        MSS(topological_order_(order));
+
+        //Longest path through the graph, with the command durations as weights
+        for (auto id: order)
+        {
+            auto & job = jobs_[id];
+            job.finish_ms = 0;
+            job.has_critical_producer = false;
+            for (auto producer: job.producers)
+            {
+                if (!job.has_critical_producer || jobs_[producer].finish_ms > job.finish_ms)
+                {
+                    job.finish_ms = jobs_[producer].finish_ms;
+                    job.critical_producer = producer;
+                    job.has_critical_producer = true;
+                }
+            }
+            job.finish_ms += job.entry.duration_ms();
+        }
+
+        if (!jobs_.empty())
+        {
+            auto it = std::max_element(jobs_.begin(), jobs_.end(), [](const Job & a, const Job & b) { return a.finish_ms < b.finish_ms; });
+            for (JobId id = it - jobs_.begin(); ; id = jobs_[id].critical_producer)
+            {
+                critical_path_.push_front(id);
+                recipe_costs_[jobs_[id].recipe].critical_ms += jobs_[id].entry.duration_ms();
+                if (!jobs_[id].has_critical_producer)
+                    break;
+            }
+        }
+
+        compute_parallelism_();
+
+        MSS_END();
+    }
+
+    void BuildTime::compute_parallelism_()
+    {
+        parallelism_.clear();
+        wall_ms_ = 0;
+
+        //Only the commands of the same run share a clock
+        bool is_timed = false;
+        unsigned int last_run = 0;
+        for (const auto & job: jobs_)
+            if (job.timed)
+            {
+                is_timed = true;
+                last_run = std::max(last_run, job.entry.run);
+            }
+        if (!is_timed)
+            return;
+
+        //Start events sort after end events at the same time, a job that starts when another finishes does not overlap with it
+        std::vector<std::pair<unsigned long, int>> events;
+        for (const auto & job: jobs_)
+            if (job.timed && job.entry.run == last_run)
+            {
+                events.emplace_back(job.entry.start_ms, 1);
+                events.emplace_back(job.entry.end_ms, -1);
+            }
+        std::sort(events.begin(), events.end());
+
+        int running = 0;
+        unsigned long previous = events.front().first;
+        for (const auto & event: events)
+        {
+            if (running > 0 && event.first > previous)
+                parallelism_[running] += event.first - previous;
+            previous = event.first;
+            running += event.second;
+        }
+
+        wall_ms_ = events.back().first - events.front().first;
+    }
+
+    void BuildTime::stream_summary(std::ostream & os) const
+    {
+        std::list<std::pair<std::string, RecipeCost>> recipes(recipe_costs_.begin(), recipe_costs_.end());
+        recipes.sort([](const auto & a, const auto & b) { return a.second.cumulative_ms > b.second.cumulative_ms; });
+
+        unsigned int untimed = 0;
+        for (const auto & p: recipes)
+            untimed += p.second.untimed;
+
+        os << "Commands: " << jobs_.size() << " (" << untimed << " without timing information)" << std::endl;
+        os << "Cumulative time: " << seconds(cumulative_ms_) << "s" << std::endl;
+        os << "Wall-clock time: " << seconds(wall_ms_) << "s" << std::endl;
+        if (wall_ms_ > 0)
+        {
+            //Over the last run, as the wall-clock time
+            unsigned long running_ms = 0;
+            for (const auto & p: parallelism_)
+                running_ms += p.first*p.second;
+            os << "Average parallelism: " << std::fixed << std::setprecision(2) << double(running_ms)/wall_ms_ << std::endl;
+        }
+        os << "Critical path: " << seconds(critical_path_ms()) << "s" << std::endl;
+
+        os << std::endl << "Critical path:" << std::endl;
+        for (auto id: critical_path_)
+        {
+            const auto & job = jobs_[id];
+            os << "  " << std::setw(10) << seconds(job.entry.duration_ms()) << "s  " << job.recipe << "  " << (job.outputs.empty() ? std::string() : job.outputs.front()) << std::endl;
+        }
+
+        os << std::endl << "Recipes (cumulative, on critical path, commands):" << std::endl;
+        for (const auto & p: recipes)
+            os << "  " << std::setw(10) << seconds(p.second.cumulative_ms) << "s  " << std::setw(10) << seconds(p.second.critical_ms) << "s  " << std::setw(6) << p.second.jobs << "  " << p.first << std::endl;
+
+        os << std::endl << "Parallelism (running commands, wall-clock time):" << std::endl;
+        for (const auto & p: parallelism_)
+            os << "  " << std::setw(4) << p.first << "  " << std::setw(10) << seconds(p.second) << "s" << std::endl;
+    }
+
+    void BuildTime::stream_report(std::ostream & os) const
+    {
+        os << "{" << std::endl;
+        os << "  \"commands\": " << jobs_.size() << "," << std::endl;
+        os << "  \"cumulative_ms\": " << cumulative_ms_ << "," << std::endl;
+        os << "  \"wall_ms\": " << wall_ms_ << "," << std::endl;
+        os << "  \"critical_path_ms\": " << critical_path_ms() << "," << std::endl;
+
+        os << "  \"critical_path\": [";
+        for (auto it = critical_path_.begin(); it != critical_path_.end(); ++it)
+        {
+            const auto & job = jobs_[*it];
+            os << (it == critical_path_.begin() ? "" : ",") << std::endl;
+            os << "    { \"recipe\": \"" << escape_json(job.recipe) << "\", \"output\": \"" << escape_json(job.outputs.empty() ? std::string() : job.outputs.front()) << "\", ";
+            os << "\"duration_ms\": " << job.entry.duration_ms() << ", \"finish_ms\": " << job.finish_ms << " }";
+        }
+        os << std::endl << "  ]," << std::endl;
+
+        os << "  \"recipes\": [";
+        for (auto it = recipe_costs_.begin(); it != recipe_costs_.end(); ++it)
+        {
+            const auto & cost = it->second;
+            os << (it == recipe_costs_.begin() ? "" : ",") << std::endl;
+            os << "    { \"uri\": \"" << escape_json(it->first) << "\", \"commands\": " << cost.jobs << ", \"untimed\": " << cost.untimed << ", ";
+            os << "\"cumulative_ms\": " << cost.cumulative_ms << ", \"critical_ms\": " << cost.critical_ms << " }";
+        }
+        os << std::endl << "  ]," << std::endl;
+
+        os << "  \"parallelism\": [";
+        for (auto it = parallelism_.begin(); it != parallelism_.end(); ++it)
+        {
+            os << (it == parallelism_.begin() ? "" : ",") << std::endl;
+            os << "    { \"running\": " << it->first << ", \"wall_ms\": " << it->second << " }";
+        }
+        os << std::endl << "  ]" << std::endl;
+        os << "}" << std::endl;
+    }
+
+} } }
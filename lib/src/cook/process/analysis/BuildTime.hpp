@@ -0,0 +1,98 @@
+#ifndef HEADER_cook_process_analysis_BuildTime_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_analysis_BuildTime_hpp_ALREADY_INCLUDED
+
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+
+namespace cook { namespace process { namespace analysis {
+
+    //The timing of a single build statement, as recorded by ninja in its .ninja_log
+    struct LogEntry
+    {
+        unsigned long start_ms = 0;
+        unsigned long end_ms = 0;
+        //Ninja appends the commands of a build in the order they finish, with times relative to the start of that build.
+        //A decreasing end time starts the next run, the timings of different runs cannot be compared.
+        unsigned int run = 0;
+
+        unsigned long duration_ms() const { return end_ms - start_ms; }
+    };
+
+    //Keyed on the normalized output filename, later entries in the log overwrite earlier ones
+    using NinjaLog = std::map<std::string, LogEntry>;
+
+    Result parse(NinjaLog & log, std::istream & is);
+    Result read(NinjaLog & log, const std::filesystem::path & fn);
+
+    std::string normalize(const std::filesystem::path & path);
+
+    //Joins the ninja timings with the commands of the build graph
+    class BuildTime
+    {
+    public:
+        using JobId = std::size_t;
+
+        JobId add_job(const std::string & recipe, const std::list<std::filesystem::path> & outputs);
+        //The consumer has to wait for the producer to finish
+        void add_dependency(JobId consumer, JobId producer);
+
+        //Computes the critical path, the per-recipe cost and the parallelism profile
+        Result analyse(const NinjaLog & log);
+
+        void stream_summary(std::ostream & os) const;
+        void stream_report(std::ostream & os) const;
+
+        struct Job
+        {
+            std::string recipe;
+            std::list<std::string> outputs;
+            std::set<JobId> producers;
+
+            bool timed = false;
+            LogEntry entry;
+            //Earliest time this job can be finished when the build would have infinite parallelism
+            unsigned long finish_ms = 0;
+            JobId critical_producer = 0;
+            bool has_critical_producer = false;
+        };
+
+        struct RecipeCost
+        {
+            unsigned int jobs = 0;
+            unsigned int untimed = 0;
+            unsigned long cumulative_ms = 0;
+            unsigned long critical_ms = 0;
+        };
+
+        const std::vector<Job> & jobs() const { return jobs_; }
+        const std::list<JobId> & critical_path() const { return critical_path_; }
+        unsigned long critical_path_ms() const;
+        const std::map<std::string, RecipeCost> & recipe_costs() const { return recipe_costs_; }
+
+        //Wall-clock time, spent with a given number of jobs running concurrently, for the commands of the last run only
+        const std::map<unsigned int, unsigned long> & parallelism() const { return parallelism_; }
+        unsigned long wall_ms() const { return wall_ms_; }
+        unsigned long cumulative_ms() const { return cumulative_ms_; }
+
+    private:
+        Result topological_order_(std::vector<JobId> & order) const;
+        void compute_parallelism_();
+
+        std::vector<Job> jobs_;
+        std::list<JobId> critical_path_;
+        std::map<std::string, RecipeCost> recipe_costs_;
+        std::map<unsigned int, unsigned long> parallelism_;
+        unsigned long wall_ms_ = 0;
+        unsigned long cumulative_ms_ = 0;
+    };
+
+} } }
+
+#endif
@@ -29,10 +29,11 @@ Result Graph::add_edge(vertex_descriptor consumer, vertex_descriptor producer, E
 
     MSS(consumer_label.index() !=  producer_label.index());
 
-    const FileLabel * lbl = std::get_if<FileLabel>(&producer_label);
+    // a file is consumer of exactly one command: the one generating it
+    const FileLabel * lbl = std::get_if<FileLabel>(&consumer_label);
     if (!!lbl)
     {
-        auto p = gubg::graph::in_edges(producer, g_);
+        auto p = gubg::graph::out_edges(consumer, g_);
         MSG_MSS(p.empty(), InternalError, "file " << *lbl << " is already generated by another command");
     }
 
@@ -25,6 +25,7 @@ struct Graph
     {
         Explicit = 0x01,
         Implicit = 0x02,
+        OrderOnly = 0x04,
     };
     using graph_type = gubg::graph::AdjacencyList<gubg::graph::use_vector, gubg::graph::use_list, gubg::graph::use_list, Label, EdgeType, gubg::graph::bidirectional>;
     using vertex_descriptor = gubg::graph::Traits<graph_type>::vertex_descriptor;
@@ -113,17 +113,13 @@ Result CompileArchiveLink::initialize()
                 return false;
             }
 
-            //TODO: In the future, this should be allowed.
-            if (!recipe->dependency_pairs().empty())
-            {
-                reason = gubg::stream([](auto & os) {os << "A script recipe cannot have dependencies"; });
-                return false;
-            }
-
             return true;
         };
 
-        set.souschefs.push_back(std::make_shared<souschef::ScriptRunner>(execute_scripts_));
+        auto rule_set = create_rule_set_();
+        set.souschefs.push_back(std::make_shared<souschef::Resolver>(rule_set));
+        set.souschefs.push_back(std::make_shared<souschef::DependentPropagator>());
+        set.souschefs.push_back(std::make_shared<souschef::ScriptRunner>(execute_scripts_, rule_set));
         this->add_brigade(default_priority-2, std::move(set));
     }
 
@@ -150,10 +146,8 @@ void CompileArchiveLink::set_archiver(SouschefPtr archiver)
     archiver_ = archiver;
 }
 
-std::list<SouschefPtr> CompileArchiveLink::generate_compile_only_steps_() const
+rules::RuleSet::Ptr CompileArchiveLink::create_rule_set_() const
 {
-    std::list<SouschefPtr> result;
-
     auto rule_set = rules::RuleSet::create();
     rule_set->add<rules::CXX>();
     rule_set->add<rules::Cc>();
@@ -162,7 +156,14 @@ std::list<SouschefPtr> CompileArchiveLink::generate_compile_only_steps_() const
     rule_set->add<rules::ASM>();
     rule_set->add<rules::Resource>();
     rule_set->add<rules::Definition>();
-    result.push_back(std::make_shared<souschef::Resolver>(rule_set));
+    return rule_set;
+}
+
+std::list<SouschefPtr> CompileArchiveLink::generate_compile_only_steps_() const
+{
+    std::list<SouschefPtr> result;
+
+    result.push_back(std::make_shared<souschef::Resolver>(create_rule_set_()));
 
     result.push_back(std::make_shared<souschef::DependentPropagator>());
 
@@ -2,6 +2,7 @@
 #define HEADER_cook_process_chef_CompileArchiveLink_hpp_ALREADY_INCLUDED
 
 #include "cook/process/chef/Interface.hpp"
+#include "cook/rules/RuleSet.hpp"
 #include <set>
 
 namespace cook { namespace process { namespace chef {
@@ -20,6 +21,7 @@ namespace cook { namespace process { namespace chef {
     private:
         const bool execute_scripts_;
 
+        rules::RuleSet::Ptr create_rule_set_() const;
         std::list<SouschefPtr> generate_compile_only_steps_() const;
 
         std::map<Language, SouschefPtr> compilers_;
@@ -60,7 +60,15 @@ Result Interface::mis_en_place_(model::Recipe & recipe, RecipeFilteredGraph & fi
     for(SouschefPtr souschef : brigade.souschefs)
     {
         auto ss = log::scope("souschef", [&](auto & n) {n.attr("description", souschef->description()); });
+        if (!timings_)
+        {
+            MSS(souschef->process(recipe, file_command_graph, context));
+            continue;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
         MSS(souschef->process(recipe, file_command_graph, context));
+        (*timings_)[souschef->description()] += std::chrono::steady_clock::now() - start;
     }
     
     {
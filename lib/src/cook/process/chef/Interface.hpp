@@ -4,6 +4,7 @@
 #include "cook/process/chef/Brigade.hpp"
 #include "cook/process/Menu.hpp"
 #include "cook/Context.hpp"
+#include <chrono>
 #include <map>
 
 namespace cook { namespace process { namespace chef {
@@ -26,10 +27,15 @@ namespace cook { namespace process { namespace chef {
 
         Result find_brigade(const Brigade *& result, model::Recipe * recipe) const;
 
+        //Accumulated processing time per souschef description, only collected when set
+        using Timings = std::map<std::string, std::chrono::duration<double>>;
+        void set_timings(Timings * timings) { timings_ = timings; }
+
     private:
         Result mis_en_place_(model::Recipe &recipe, RecipeFilteredGraph & file_command_graph, const Context & context, const Brigade &staff) const;
 
         std::multimap<unsigned int, Brigade> brigade_priority_map_;
+        Timings * timings_ = nullptr;
     };
 
 } } }
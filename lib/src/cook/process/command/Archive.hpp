@@ -31,11 +31,16 @@ namespace cook { namespace process { namespace command {
             return false; 
         }
         
-        bool delete_before_build() const override { return true; }
+        //An incremental archive is updated in place, only the changed members are replaced
+        void set_incremental(bool incremental) { incremental_ = incremental; }
+        bool delete_before_build() const override { return !incremental_; }
 
         std::string name() const override {return "Archive";}
         Type type() const override {return Type::Archive;}
         Result process() override {return Result();}
+
+    private:
+        bool incremental_ = false;
     };
 
 } } } 
@@ -0,0 +1,58 @@
+#ifndef HEADER_cook_process_command_Collate_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_command_Collate_hpp_ALREADY_INCLUDED
+
+#include "cook/process/command/CommonImpl.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <memory>
+
+namespace cook { namespace process { namespace command { 
+
+    //Collates the scanned module information of a recipe into a ninja dyndep file and the module maps
+    //of its objects. This command runs cook itself in collation mode (--collate-modules).
+    class Collate: public CommonImpl
+    {
+    public:
+        using Ptr = std::shared_ptr<Collate>;
+
+        Collate(const std::filesystem::path & executable, const std::string & format, const std::filesystem::path & bmi_dir, model::Recipe & recipe)
+            : CommonImpl(create_element_(recipe))
+        {
+            key_values_(toolchain::Part::Cli).emplace_back(escape_spaces(executable.string()), "");
+            key_values_(toolchain::Part::Pre).emplace_back("--verbosity", "0");
+            key_values_(toolchain::Part::Pre).emplace_back("--collate-modules", format);
+            key_values_(toolchain::Part::Pre).emplace_back("--bmi-dir", escape_spaces(bmi_dir.string()));
+        }
+
+        std::string name() const override {return "Collate";}
+        Type type() const override {return Type::Collate;}
+        bool restat() const override { return true; }
+
+        //Module information of the dependencies: only used to resolve the imports
+        void add_module_info(const std::filesystem::path & fn)
+        {
+            key_values_(toolchain::Part::Pre).emplace_back("--module-info", escape_spaces(fn.string()));
+        }
+
+        Result process() override {return Result();}
+
+    private:
+        static toolchain::Element::Ptr create_element_(model::Recipe & recipe)
+        {
+            using toolchain::Part;
+
+            auto ptr = std::make_shared<toolchain::Element>(toolchain::Element::UserDefined, Language::CXX, TargetType::Object);
+            ptr->set_recipe(&recipe);
+
+            auto & tm = ptr->translator_map();
+            tm[Part::Cli]       = [](const std::string & k, const std::string & v) { return k; };
+            tm[Part::Pre]       = [](const std::string & k, const std::string & v) { return v.empty() ? k : k + " " + v; };
+            tm[Part::Output]    = [](const std::string & k, const std::string & v) { return "--dyndep " + k; };
+            tm[Part::Input]     = [](const std::string & k, const std::string & v) { return k; };
+
+            return ptr;
+        }
+    };
+
+} } } 
+
+#endif
@@ -14,13 +14,13 @@ namespace cook { namespace process { namespace command {
     void CommonImpl::set_inputs_outputs(const Filenames& input_files, const Filenames& output_files)
     {
         {
-            auto& inputs = kvm_[toolchain::Part::Input];
+            auto& inputs = key_values_(toolchain::Part::Input);
             inputs.clear();
             for (const auto& fn : input_files)
                 inputs.emplace_back(escape_spaces(fn.string()), "");
         }
         {
-            auto& outputs = kvm_[toolchain::Part::Output];
+            auto& outputs = key_values_(toolchain::Part::Output);
             outputs.clear();
             for (const auto& fn : output_files)
                 outputs.emplace_back(escape_spaces(fn.string()), "");
@@ -36,6 +36,25 @@ namespace cook { namespace process { namespace command {
 
     bool CommonImpl::stream_part(std::ostream & os, toolchain::Part part, const toolchain::Translator *trans_ptr, const PartEscapeFunctor & functor) const 
     {
+        auto stream_str = [&](gubg::OnlyOnce & skip_space, const std::string & str)
+        {
+            if (!skip_space())
+                os << ' ';
+            if (functor)
+                os << functor(part, str);
+            else
+                os << str;
+        };
+
+        if (!trans_ptr)
+        {
+            const auto & translation = translation_(part);
+            gubg::OnlyOnce skip_space;
+            for (const auto & str: translation.strs)
+                stream_str(skip_space, str);
+            return translation.has_key_values;
+        }
+
         auto kvs_it = kvm_.find(part);
         if (kvs_it == kvm_.end())
             return false;
@@ -43,22 +62,12 @@ namespace cook { namespace process { namespace command {
         if (kvs.empty())
             return false;
 
-        auto it = trans_.find(part);
-        assert(it != trans_.end());
-        const auto &trans = (!!trans_ptr ? *trans_ptr : it->second);
         gubg::OnlyOnce skip_space;
         for (const auto &kv: kvs)
         {
-            const auto str = trans(kv.first, kv.second);
+            const auto str = (*trans_ptr)(kv.first, kv.second);
             if (!str.empty())
-            {
-                if (!skip_space())
-                    os << ' ';
-                if (functor)
-                    os << functor(part, str);
-                else
-                    os << str;
-            }
+                stream_str(skip_space, str);
         }
         return true;
     }
@@ -72,6 +81,46 @@ namespace cook { namespace process { namespace command {
         };
         toolchain::each_part(lambda);
     }
+
+    const CommonImpl::Translation & CommonImpl::translation_(toolchain::Part part) const
+    {
+        std::lock_guard<std::mutex> lock(translations_mutex_);
+
+        auto & translation = translations_[(unsigned int)part];
+        if (translation.valid)
+            return translation;
+
+        translation.valid = true;
+        translation.has_key_values = false;
+        translation.strs.clear();
+
+        auto kvs_it = kvm_.find(part);
+        if (kvs_it == kvm_.end() || kvs_it->second.empty())
+            return translation;
+        translation.has_key_values = true;
+
+        auto it = trans_.find(part);
+        assert(it != trans_.end());
+        for (const auto &kv: kvs_it->second)
+        {
+            auto str = it->second(kv.first, kv.second);
+            if (!str.empty())
+                translation.strs.push_back(std::move(str));
+        }
+        return translation;
+    }
+
+    toolchain::KeyValues & CommonImpl::key_values_(toolchain::Part part)
+    {
+        invalidate_(part);
+        return ptr_->key_values_map()[part];
+    }
+
+    void CommonImpl::invalidate_all_()
+    {
+        for (auto & translation: translations_)
+            translation.valid = false;
+    }
     
     std::string CommonImpl::escape_spaces(const std::string & str)
     {
@@ -85,11 +134,14 @@ namespace cook { namespace process { namespace command {
         
     bool CommonImpl::process_ingredient(const LanguageTypePair& ltp, const ingredient::File& file)
     {
+        //The element decides which parts are affected
+        invalidate_all_();
         return ptr_->process_ingredient(ltp, file); 
     }
 
     bool CommonImpl::process_ingredient(const LanguageTypePair& ltp, const ingredient::KeyValue& key_value)
     {
+        invalidate_all_();
         return ptr_->process_ingredient(ltp, key_value); 
     }
 
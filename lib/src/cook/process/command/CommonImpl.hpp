@@ -6,6 +6,9 @@
 #include "cook/process/toolchain/Types.hpp"
 #include "cook/Language.hpp"
 #include "gubg/OnlyOnce.hpp"
+#include <array>
+#include <vector>
+#include <mutex>
 
 namespace cook { namespace process { namespace command { 
 
@@ -23,16 +26,39 @@ namespace cook { namespace process { namespace command {
         bool process_ingredient(const LanguageTypePair& ltp, const ingredient::File& file) override;
         bool process_ingredient(const LanguageTypePair& ltp, const ingredient::KeyValue& key_value) override;
         bool delete_before_build() const override { return false; }
+        const Filename & dyndep() const override { return dyndep_; }
+        bool restat() const override { return false; }
 
+        void set_dyndep(const Filename & dyndep) { dyndep_ = dyndep; }
 
     protected:
         static std::string escape_spaces(const std::string & str);
+
+        //Write access to the key-values of a part, its translation is redone when the command is streamed again
+        toolchain::KeyValues & key_values_(toolchain::Part part);
         
         toolchain::Element::Ptr ptr_;
-        toolchain::KeyValuesMap & kvm_;
+        const toolchain::KeyValuesMap & kvm_;
         toolchain::TranslatorMap & trans_;
         const Language language_;
+        Filename dyndep_;
+
+    private:
+        //The translated key-values of a single part. Only the inputs and outputs change from one
+        //build statement to the next, the other parts are translated once and reused afterwards.
+        struct Translation
+        {
+            bool valid = false;
+            bool has_key_values = false;
+            std::vector<std::string> strs;
+        };
+        const Translation & translation_(toolchain::Part part) const;
+        void invalidate_(toolchain::Part part) { translations_[(unsigned int)part].valid = false; }
+        void invalidate_all_();
 
+        mutable std::array<Translation, (unsigned int)toolchain::Part::End_> translations_;
+        //Concurrent generators can stream the same command
+        mutable std::mutex translations_mutex_;
     };
 
 } } } 
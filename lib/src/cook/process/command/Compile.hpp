@@ -22,6 +22,17 @@ namespace cook { namespace process { namespace command {
         std::string name() const override {return "Compile";}
         Type type() const override {return Type::Compile;}
 
+        //Each output gets a module map next to it, written by the Collate command
+        void enable_module_map() { use_module_map_ = true; }
+
+        //Header map that resolves the known headers before the include paths are searched
+        void set_header_map(const std::filesystem::path & path)
+        {
+            auto & hmaps = key_values_(toolchain::Part::HeaderMap);
+            hmaps.clear();
+            hmaps.emplace_back(escape_spaces(path.string()), "");
+        }
+
         virtual bool process_ingredient(const LanguageTypePair& ltp, const ingredient::File& file) override
         { 
             if (false) 
@@ -67,13 +78,13 @@ namespace cook { namespace process { namespace command {
             if (language_ == Language::Resource)
             {
                 {
-                    auto &inputs = kvm_[toolchain::Part::Resource];
+                    auto &inputs = key_values_(toolchain::Part::Resource);
                     inputs.clear();
                     for (const auto &fn: input_files)
                         inputs.emplace_back(escape_spaces(fn.string()), "");
                 }
                 {
-                    auto &outputs = kvm_[toolchain::Part::Output];
+                    auto &outputs = key_values_(toolchain::Part::Output);
                     outputs.clear();
                     for (const auto &fn: output_files)
                         outputs.emplace_back(escape_spaces(fn.string()), "");
@@ -85,8 +96,8 @@ namespace cook { namespace process { namespace command {
 
                 //Create the depfiles by appending ".d" to the output files
                 {
-                    const auto &outputs = kvm_[toolchain::Part::Output];
-                    auto &depfiles = kvm_[toolchain::Part::DepFile];
+                    const auto &outputs = key_values_(toolchain::Part::Output);
+                    auto &depfiles = key_values_(toolchain::Part::DepFile);
                     depfiles.clear();
                     for (const auto &p: outputs)
                     {
@@ -94,24 +105,46 @@ namespace cook { namespace process { namespace command {
                         depfiles.emplace_back(escape_spaces(fn), "");
                     }
                 }
+
+                //Create the module maps by appending ".modmap" to the output files
+                if (use_module_map_)
+                {
+                    const auto &outputs = key_values_(toolchain::Part::Output);
+                    auto &modmaps = key_values_(toolchain::Part::ModuleMap);
+                    modmaps.clear();
+                    for (const auto &p: outputs)
+                        modmaps.emplace_back(escape_spaces(p.first+".modmap"), "");
+                }
             }
         }
         Result process() override {return Result();}
 
     private:
+        bool use_module_map_ = false;
+
         void add_define_(const std::string & name, const std::string & value)
         {
-            kvm_[toolchain::Part::Define].emplace_back(name, value);
+            key_values_(toolchain::Part::Define).emplace_back(name, value);
         }
         void add_define_(const std::string & name) { add_define_(name, ""); }
 
         void add_include_path_(const std::filesystem::path & path)
         {
-            kvm_[toolchain::Part::IncludePath].emplace_back(escape_spaces(path.string()), "");
+            //Different spellings of the same directory (trailing separator, "." or ".." components) are only searched once
+            std::filesystem::path normalized = path.lexically_normal();
+            if (normalized.has_parent_path() && normalized.filename().empty())
+                normalized = normalized.parent_path();
+
+            const std::string key = escape_spaces(normalized.string());
+            auto & include_paths = key_values_(toolchain::Part::IncludePath);
+            for (const auto & p: include_paths)
+                if (p.first == key)
+                    return;
+            include_paths.emplace_back(key, "");
         }
         void add_force_include_(const std::filesystem::path & path)
         {
-            kvm_[toolchain::Part::ForceInclude].emplace_back(escape_spaces(path.string()), "");
+            key_values_(toolchain::Part::ForceInclude).emplace_back(escape_spaces(path.string()), "");
         }
     };
 
@@ -24,6 +24,9 @@ namespace cook { namespace process { namespace command {
             Compile,
             Archive,
             Link,
+            Scan,
+            Collate,
+            Script,
             UserDefined
         };
 
@@ -43,6 +46,11 @@ namespace cook { namespace process { namespace command {
         virtual bool process_ingredient(const LanguageTypePair& ltp, const ingredient::File& file)  = 0;
         virtual bool process_ingredient(const LanguageTypePair& ltp, const ingredient::KeyValue& key_value)  = 0;
         virtual bool delete_before_build() const = 0;
+
+        //The ninja dyndep file that completes the dependencies of this command, if any
+        virtual const Filename & dyndep() const = 0;
+        //Whether the outputs are only rewritten when their content changes
+        virtual bool restat() const = 0;
     };
 
     inline std::ostream & operator<<(std::ostream & str, Interface::Type type)
@@ -53,6 +61,9 @@ namespace cook { namespace process { namespace command {
             L_CASE(Compile, "compile");
             L_CASE(Archive, "archive");
             L_CASE(Link, "link");
+            L_CASE(Scan, "scan");
+            L_CASE(Collate, "collate");
+            L_CASE(Script, "script");
 #undef L_CASE
             default: break;
         }
@@ -75,26 +75,32 @@ namespace cook { namespace process { namespace command {
             return false; 
         }
 
+        //The linker places the functions in the order of this file, the option is toolchain specific
+        void add_symbol_ordering_file(const std::string & option, const std::filesystem::path & path)
+        {
+            key_values_(toolchain::Part::Pre).emplace_back(option + escape_spaces(path.string()), "");
+        }
+
     private:
         void add_library_(const std::string & name)
         {
-            kvm_[toolchain::Part::Library].emplace_back(name, "");
+            key_values_(toolchain::Part::Library).emplace_back(name, "");
         }
         void add_library_path_(const std::filesystem::path & path)
         {
-            kvm_[toolchain::Part::LibraryPath].emplace_back(escape_spaces(path.string()), "");
+            key_values_(toolchain::Part::LibraryPath).emplace_back(escape_spaces(path.string()), "");
         }
         void add_framework_(const std::string & name)
         {
-            kvm_[toolchain::Part::Framework].emplace_back(name, "");
+            key_values_(toolchain::Part::Framework).emplace_back(name, "");
         }
         void add_framework_path_(const std::filesystem::path & path)
         {
-            kvm_[toolchain::Part::FrameworkPath].emplace_back(escape_spaces(path.string()), "");
+            key_values_(toolchain::Part::FrameworkPath).emplace_back(escape_spaces(path.string()), "");
         }
         void add_export_(const std::filesystem::path & path)
         {
-            kvm_[toolchain::Part::Export].emplace_back(escape_spaces(path.string()), "");
+            key_values_(toolchain::Part::Export).emplace_back(escape_spaces(path.string()), "");
         }
     };
 
@@ -0,0 +1,57 @@
+#ifndef HEADER_cook_process_command_PostLink_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_command_PostLink_hpp_ALREADY_INCLUDED
+
+#include "cook/process/command/CommonImpl.hpp"
+#include <memory>
+
+namespace cook { namespace process { namespace command {
+
+    //Runs BOLT on a linked executable, with a recorded profile. Depending on the output option, it writes
+    //the optimized executable or the function order for the linker.
+    class PostLink: public CommonImpl
+    {
+    public:
+        using Ptr = std::shared_ptr<PostLink>;
+
+        PostLink(const std::string & bolt, const std::string & output_option, model::Recipe & recipe)
+            : CommonImpl(create_element_(output_option, recipe))
+        {
+            key_values_(toolchain::Part::Cli).emplace_back(escape_spaces(bolt), "");
+        }
+
+        std::string name() const override {return "PostLink";}
+        //BOLT needs about as much memory as the link itself, it shares the link pool
+        Type type() const override {return Type::Link;}
+
+        void add_argument(const std::string & argument)
+        {
+            key_values_(toolchain::Part::Option).emplace_back(argument, "");
+        }
+        void add_argument(const std::string & option, const std::filesystem::path & path)
+        {
+            key_values_(toolchain::Part::Option).emplace_back(option + escape_spaces(path.string()), "");
+        }
+
+        Result process() override {return Result();}
+
+    private:
+        static toolchain::Element::Ptr create_element_(const std::string & output_option, model::Recipe & recipe)
+        {
+            using toolchain::Part;
+
+            auto ptr = std::make_shared<toolchain::Element>(toolchain::Element::UserDefined, Language::Binary, TargetType::Executable);
+            ptr->set_recipe(&recipe);
+
+            auto & tm = ptr->translator_map();
+            tm[Part::Cli]       = [](const std::string & k, const std::string & v) { return k; };
+            tm[Part::Output]    = [=](const std::string & k, const std::string & v) { return output_option + k; };
+            tm[Part::Input]     = [](const std::string & k, const std::string & v) { return k; };
+            tm[Part::Option]    = [](const std::string & k, const std::string & v) { return k; };
+
+            return ptr;
+        }
+    };
+
+} } }
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef HEADER_cook_process_command_Scan_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_command_Scan_hpp_ALREADY_INCLUDED
+
+#include "cook/process/command/Compile.hpp"
+#include <memory>
+#include <string>
+
+namespace cook { namespace process { namespace command { 
+
+    //Runs the preprocessor on a translation unit to extract its module dependencies (P1689)
+    class Scan: public Compile
+    {
+    public:
+        using Ptr = std::shared_ptr<Scan>;
+
+        Scan(toolchain::Element::Ptr ptr)
+            : Compile(ptr)
+        {
+        }
+
+        std::string name() const override {return "Scan";}
+        Type type() const override {return Type::Scan;}
+
+        //The value of each output is the primary output of its rule: the object, without the ".ddi" extension
+        void set_inputs_outputs(const Filenames & input_files, const Filenames & output_files) override
+        {
+            Compile::set_inputs_outputs(input_files, output_files);
+
+            const std::string extension = ".ddi";
+            for (auto & p: key_values_(toolchain::Part::Output))
+            {
+                const auto & fn = p.first;
+                const bool has_extension = (fn.size() >= extension.size() && fn.compare(fn.size() - extension.size(), extension.size(), extension) == 0);
+                p.second = (has_extension ? fn.substr(0, fn.size() - extension.size()) : fn);
+            }
+        }
+    };
+
+} } } 
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef HEADER_cook_process_command_Script_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_command_Script_hpp_ALREADY_INCLUDED
+
+#include "cook/process/command/CommonImpl.hpp"
+#include "cook/OS.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <memory>
+
+namespace cook { namespace process { namespace command { 
+
+    //Runs the commands of a script recipe as part of the build, from the directory cook was started in
+    class Script: public CommonImpl
+    {
+    public:
+        using Ptr = std::shared_ptr<Script>;
+
+        Script(const std::filesystem::path & working_directory, model::Recipe & recipe)
+            : CommonImpl(create_element_(recipe))
+        {
+            //cmd /c executes the remainder of the command line, including the chaining
+            const std::string cd = (get_os() == OS::Windows ? "cmd /c cd /d " : "cd ");
+            key_values_(toolchain::Part::Cli).emplace_back(cd + escape_spaces(working_directory.string()), "");
+        }
+
+        std::string name() const override {return "Script";}
+        Type type() const override {return Type::Script;}
+        //Code generators typically leave unchanged outputs untouched
+        bool restat() const override { return true; }
+
+        void add_command(const std::string & command)
+        {
+            key_values_(toolchain::Part::Pre).emplace_back(command, "");
+        }
+
+        Result process() override {return Result();}
+
+    private:
+        static toolchain::Element::Ptr create_element_(model::Recipe & recipe)
+        {
+            using toolchain::Part;
+
+            auto ptr = std::make_shared<toolchain::Element>(toolchain::Element::UserDefined, Language::Script, TargetType::Script);
+            ptr->set_recipe(&recipe);
+
+            auto & tm = ptr->translator_map();
+            tm[Part::Cli]       = [](const std::string & k, const std::string & v) { return k; };
+            tm[Part::Pre]       = [](const std::string & k, const std::string & v) { return "&& " + k; };
+            //The inputs and outputs are part of the user commands
+            tm[Part::Input]     = [](const std::string & k, const std::string & v) { return ""; };
+            tm[Part::Output]    = [](const std::string & k, const std::string & v) { return ""; };
+
+            return ptr;
+        }
+    };
+
+} } } 
+
+#endif
@@ -0,0 +1,198 @@
+#include "cook/process/module/Collator.hpp"
+#include "cook/util/File.hpp"
+#include <algorithm>
+#include <sstream>
+#include <set>
+
+namespace cook { namespace process { namespace module {
+
+    namespace {
+
+        std::string escape_ninja(const std::string & str)
+        {
+            std::string res;
+            for (const auto ch: str)
+            {
+                if (ch == ':' || ch == ' ' || ch == '$')
+                    res += '$';
+                res += ch;
+            }
+            return res;
+        }
+
+        std::string module_map_filename(const std::filesystem::path & object)
+        {
+            return object.string() + ".modmap";
+        }
+
+    }
+
+    bool parse(Format & format, const std::string & str)
+    {
+        if (false) {}
+        else if (str == "gcc")      { format = Format::GCC; }
+        else if (str == "clang")    { format = Format::Clang; }
+        else                        { return false; }
+
+        return true;
+    }
+
+    Collator::Collator(Format format, const std::filesystem::path & bmi_dir)
+        : format_(format),
+        bmi_dir_(bmi_dir)
+    {
+    }
+
+    Result Collator::add_own(const std::filesystem::path & module_info_fn, const P1689 & info)
+    {
+        MSS_BEGIN(Result);
+
+        MSG_MSS(module_info_fn.extension() == ".ddi", InternalError, "Module information file '" << module_info_fn.string() << "' should have the .ddi extension");
+
+        //Each object needs an entry in the dyndep file and a module map, even when it does not use modules
+        Unit unit;
+        unit.object = module_info_fn.parent_path() / module_info_fn.stem();
+        if (info.rules.empty())
+            own_.push_back(unit);
+        for (const auto & rule: info.rules)
+        {
+            unit.rule = rule;
+            own_.push_back(unit);
+        }
+        MSS(add_dependency(info));
+
+        MSS_END();
+    }
+
+    Result Collator::add_dependency(const P1689 & info)
+    {
+        MSS_BEGIN(Result);
+
+        for (const auto & rule: info.rules)
+            for (const auto & provide: rule.provides)
+            {
+                auto p = provider_per_module_.emplace(provide.logical_name, rule);
+                MSG_MSS(p.second || p.first->second.primary_output == rule.primary_output, Error, "Module '" << provide.logical_name << "' is provided more than once");
+            }
+
+        MSS_END();
+    }
+
+    std::filesystem::path Collator::bmi(const std::string & logical_name) const
+    {
+        //Partitions are named "primary:partition"
+        std::string name = logical_name;
+        for (auto & ch: name)
+            if (ch == ':')
+                ch = '-';
+
+        return bmi_dir_ / (name + (format_ == Format::GCC ? ".gcm" : ".pcm"));
+    }
+
+    Result Collator::required_closure_(std::list<std::string> & names, const P1689::Rule & rule) const
+    {
+        MSS_BEGIN(Result);
+
+        std::set<std::string> done;
+        std::list<std::string> todo(rule.required.begin(), rule.required.end());
+        while (!todo.empty())
+        {
+            const std::string name = todo.front();
+            todo.pop_front();
+            if (!done.insert(name).second)
+                continue;
+
+            auto it = provider_per_module_.find(name);
+            MSG_MSS(it != provider_per_module_.end(), Error, "Module '" << name << "' is not provided by any of the scanned sources");
+
+            names.push_back(name);
+            todo.insert(todo.end(), it->second.required.begin(), it->second.required.end());
+        }
+
+        MSS_END();
+    }
+
+    Result Collator::stream_dyndep(std::ostream & os) const
+    {
+        MSS_BEGIN(Result);
+
+        os << "ninja_dyndep_version = 1" << std::endl;
+        for (const auto & unit: own_)
+        {
+            os << "build " << escape_ninja(unit.object.string());
+            if (!unit.rule.provides.empty())
+            {
+                os << " |";
+                for (const auto & provide: unit.rule.provides)
+                    os << " " << escape_ninja(bmi(provide.logical_name).string());
+            }
+            os << ": dyndep";
+            if (!unit.rule.required.empty())
+            {
+                os << " |";
+                for (const auto & name: unit.rule.required)
+                    os << " " << escape_ninja(bmi(name).string());
+            }
+            os << std::endl;
+        }
+
+        MSS_END();
+    }
+
+    Result Collator::stream_module_map(std::ostream & os, const std::filesystem::path & object) const
+    {
+        MSS_BEGIN(Result);
+
+        auto it = std::find_if(own_.begin(), own_.end(), [&](const Unit & unit) { return unit.object == object; });
+        MSG_MSS(it != own_.end(), InternalError, "No module information found for '" << object.string() << "'");
+
+        //Clang needs the complete set of transitively imported modules, gcc resolves them via the mapper
+        std::list<std::string> required;
+        MSS(required_closure_(required, it->rule));
+
+        switch (format_)
+        {
+            case Format::GCC:
+                for (const auto & provide: it->rule.provides)
+                    os << provide.logical_name << " " << bmi(provide.logical_name).string() << std::endl;
+                for (const auto & name: required)
+                    os << name << " " << bmi(name).string() << std::endl;
+                break;
+
+            case Format::Clang:
+                for (const auto & provide: it->rule.provides)
+                    if (provide.is_interface)
+                        os << "-fmodule-output=" << bmi(provide.logical_name).string() << std::endl;
+                for (const auto & name: required)
+                    os << "-fmodule-file=" << name << "=" << bmi(name).string() << std::endl;
+                break;
+        }
+
+        MSS_END();
+    }
+
+    Result Collator::write(const std::filesystem::path & dyndep_fn) const
+    {
+        MSS_BEGIN(Result);
+
+        {
+            std::ostringstream oss;
+            MSS(stream_dyndep(oss));
+            MSS(util::write_if_changed(dyndep_fn, oss.str()));
+        }
+
+        std::set<std::filesystem::path> objects;
+        for (const auto & unit: own_)
+        {
+            if (!objects.insert(unit.object).second)
+                continue;
+
+            std::ostringstream oss;
+            MSS(stream_module_map(oss, unit.object));
+            MSS(util::write_if_changed(module_map_filename(unit.object), oss.str()));
+        }
+
+        MSS_END();
+    }
+
+} } }
@@ -0,0 +1,58 @@
+#ifndef HEADER_cook_process_module_Collator_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_module_Collator_hpp_ALREADY_INCLUDED
+
+#include "cook/process/module/P1689.hpp"
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <ostream>
+#include <string>
+#include <map>
+#include <list>
+
+namespace cook { namespace process { namespace module {
+
+    enum class Format
+    {
+        GCC, Clang,
+    };
+
+    bool parse(Format & format, const std::string & str);
+
+    //Combines the scanned module information of a recipe (and that of its dependencies) into:
+    // * a ninja dyndep file specifying which compiled module interfaces each object provides and requires
+    // * a module map per object, telling the compiler where to find (or put) these compiled module interfaces
+    class Collator
+    {
+    public:
+        Collator(Format format, const std::filesystem::path & bmi_dir);
+
+        //The object is derived from the module information filename by dropping its ".ddi" extension
+        Result add_own(const std::filesystem::path & module_info_fn, const P1689 & info);
+        Result add_dependency(const P1689 & info);
+
+        std::filesystem::path bmi(const std::string & logical_name) const;
+
+        Result stream_dyndep(std::ostream & os) const;
+        Result stream_module_map(std::ostream & os, const std::filesystem::path & object) const;
+
+        //Writes the dyndep file and the module maps, only touching the files that changed
+        Result write(const std::filesystem::path & dyndep_fn) const;
+
+    private:
+        struct Unit
+        {
+            std::filesystem::path object;
+            P1689::Rule rule;
+        };
+
+        Result required_closure_(std::list<std::string> & names, const P1689::Rule & rule) const;
+
+        Format format_;
+        std::filesystem::path bmi_dir_;
+        std::list<Unit> own_;
+        std::map<std::string, P1689::Rule> provider_per_module_;
+    };
+
+} } }
+
+#endif
@@ -0,0 +1,244 @@
+#include "cook/process/module/P1689.hpp"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cctype>
+
+namespace cook { namespace process { namespace module {
+
+    namespace {
+
+        //Minimal json representation, sufficient for the P1689 files
+        struct Value
+        {
+            enum Kind { Null, Bool, Number, String, Array, Object };
+
+            Kind kind = Null;
+            bool boolean = false;
+            std::string str;
+            std::vector<Value> array;
+            std::vector<std::pair<std::string, Value>> object;
+
+            const Value * find(const std::string & key) const
+            {
+                for (const auto & p: object)
+                    if (p.first == key)
+                        return &p.second;
+                return nullptr;
+            }
+        };
+
+        class Parser
+        {
+        public:
+            explicit Parser(const std::string & content): content_(content) {}
+
+            bool parse(Value & value)
+            {
+                MSS_BEGIN(bool);
+                MSS(parse_value_(value));
+                skip_ws_();
+                MSS(pos_ == content_.size());
+                MSS_END();
+            }
+
+            std::size_t position() const { return pos_; }
+
+        private:
+            void skip_ws_()
+            {
+                while (pos_ < content_.size() && std::isspace(static_cast<unsigned char>(content_[pos_])))
+                    ++pos_;
+            }
+            bool pop_if_(char ch)
+            {
+                skip_ws_();
+                if (pos_ >= content_.size() || content_[pos_] != ch)
+                    return false;
+                ++pos_;
+                return true;
+            }
+            bool pop_if_(const std::string & word)
+            {
+                skip_ws_();
+                if (content_.compare(pos_, word.size(), word) != 0)
+                    return false;
+                pos_ += word.size();
+                return true;
+            }
+
+            bool parse_value_(Value & value)
+            {
+                MSS_BEGIN(bool);
+
+                skip_ws_();
+                MSS(pos_ < content_.size());
+
+                const char ch = content_[pos_];
+                if (false) {}
+                else if (ch == '{')
+                {
+                    value.kind = Value::Object;
+                    MSS(pop_if_('{'));
+                    if (!pop_if_('}'))
+                    {
+                        do
+                        {
+                            std::string key;
+                            MSS(parse_string_(key));
+                            MSS(pop_if_(':'));
+                            value.object.emplace_back(key, Value());
+                            MSS(parse_value_(value.object.back().second));
+                        } while (pop_if_(','));
+                        MSS(pop_if_('}'));
+                    }
+                }
+                else if (ch == '[')
+                {
+                    value.kind = Value::Array;
+                    MSS(pop_if_('['));
+                    if (!pop_if_(']'))
+                    {
+                        do
+                        {
+                            value.array.emplace_back();
+                            MSS(parse_value_(value.array.back()));
+                        } while (pop_if_(','));
+                        MSS(pop_if_(']'));
+                    }
+                }
+                else if (ch == '"')
+                {
+                    value.kind = Value::String;
+                    MSS(parse_string_(value.str));
+                }
+                else if (pop_if_("true"))   { value.kind = Value::Bool; value.boolean = true; }
+                else if (pop_if_("false"))  { value.kind = Value::Bool; value.boolean = false; }
+                else if (pop_if_("null"))   { value.kind = Value::Null; }
+                else
+                {
+                    value.kind = Value::Number;
+                    const auto begin = pos_;
+                    while (pos_ < content_.size() && (std::isdigit(static_cast<unsigned char>(content_[pos_])) || std::string("+-.eE").find(content_[pos_]) != std::string::npos))
+                        ++pos_;
+                    MSS(pos_ != begin);
+                    value.str = content_.substr(begin, pos_-begin);
+                }
+
+                MSS_END();
+            }
+
+            bool parse_string_(std::string & str)
+            {
+                MSS_BEGIN(bool);
+
+                MSS(pop_if_('"'));
+                str.clear();
+                for (; pos_ < content_.size() && content_[pos_] != '"'; ++pos_)
+                {
+                    char ch = content_[pos_];
+                    if (ch == '\\')
+                    {
+                        MSS(++pos_ < content_.size());
+                        switch (content_[pos_])
+                        {
+                            case 'n': ch = '\n'; break;
+                            case 't': ch = '\t'; break;
+                            case 'r': ch = '\r'; break;
+                            case 'b': ch = '\b'; break;
+                            case 'f': ch = '\f'; break;
+                            case 'u':
+                                  {
+                                      //Only the ascii range is expected in filenames and module names
+                                      MSS(pos_+4 < content_.size());
+                                      ch = static_cast<char>(std::stoi(content_.substr(pos_+1, 4), nullptr, 16));
+                                      pos_ += 4;
+                                  }
+                                  break;
+                            default: ch = content_[pos_]; break;
+                        }
+                    }
+                    str.push_back(ch);
+                }
+                MSS(pop_if_('"'));
+
+                MSS_END();
+            }
+
+            const std::string & content_;
+            std::size_t pos_ = 0;
+        };
+
+        Result extract_(P1689 & info, const Value & root)
+        {
+            MSS_BEGIN(Result);
+
+            MSG_MSS(root.kind == Value::Object, Error, "P1689: the root should be an object");
+
+            const Value * rules = root.find("rules");
+            MSG_MSS(!!rules && rules->kind == Value::Array, Error, "P1689: no rules are present");
+
+            for (const Value & r: rules->array)
+            {
+                MSS(r.kind == Value::Object);
+
+                P1689::Rule rule;
+                if (const Value * po = r.find("primary-output"))
+                    rule.primary_output = po->str;
+
+                if (const Value * provides = r.find("provides"))
+                    for (const Value & p: provides->array)
+                    {
+                        P1689::Provide provide;
+                        const Value * name = p.find("logical-name");
+                        MSG_MSS(!!name, Error, "P1689: provided module without logical-name in rule for '" << rule.primary_output << "'");
+                        provide.logical_name = name->str;
+                        if (const Value * is_interface = p.find("is-interface"))
+                            provide.is_interface = is_interface->boolean;
+                        rule.provides.push_back(provide);
+                    }
+
+                if (const Value * required = r.find("requires"))
+                    for (const Value & p: required->array)
+                    {
+                        const Value * name = p.find("logical-name");
+                        MSG_MSS(!!name, Error, "P1689: required module without logical-name in rule for '" << rule.primary_output << "'");
+                        rule.required.push_back(name->str);
+                    }
+
+                info.rules.push_back(rule);
+            }
+
+            MSS_END();
+        }
+
+    }
+
+    Result parse(P1689 & info, const std::string & content)
+    {
+        MSS_BEGIN(Result);
+
+        Value root;
+        Parser parser(content);
+        MSG_MSS(parser.parse(root), Error, "P1689: invalid json near position " << parser.position());
+        MSS(extract_(info, root));
+
+        MSS_END();
+    }
+
+    Result read(P1689 & info, const std::filesystem::path & fn)
+    {
+        MSS_BEGIN(Result);
+
+        std::ifstream ifs(fn.string());
+        MSG_MSS(ifs.good(), Error, "Could not open module information file '" << fn.string() << "'");
+
+        std::ostringstream oss;
+        oss << ifs.rdbuf();
+
+        MSG_MSS(parse(info, oss.str()), Error, "Could not parse module information file '" << fn.string() << "'");
+
+        MSS_END();
+    }
+
+} } }
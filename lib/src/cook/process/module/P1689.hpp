@@ -0,0 +1,35 @@
+#ifndef HEADER_cook_process_module_P1689_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_module_P1689_hpp_ALREADY_INCLUDED
+
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <string>
+#include <list>
+
+namespace cook { namespace process { namespace module {
+
+    //The module dependency information as written by the gcc and clang scanners (P1689 format)
+    struct P1689
+    {
+        struct Provide
+        {
+            std::string logical_name;
+            bool is_interface = true;
+        };
+
+        struct Rule
+        {
+            std::string primary_output;
+            std::list<Provide> provides;
+            std::list<std::string> required;
+        };
+
+        std::list<Rule> rules;
+    };
+
+    Result parse(P1689 & info, const std::string & content);
+    Result read(P1689 & info, const std::filesystem::path & fn);
+
+} } }
+
+#endif
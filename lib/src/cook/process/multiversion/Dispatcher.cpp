@@ -0,0 +1,146 @@
+#include "cook/process/multiversion/Dispatcher.hpp"
+#include <sstream>
+#include <cctype>
+
+namespace cook { namespace process { namespace multiversion {
+
+    namespace {
+
+        std::list<std::string> split(const std::string & str)
+        {
+            std::list<std::string> res;
+            std::istringstream iss(str);
+            std::string word;
+            while (iss >> word)
+                res.push_back(word);
+            return res;
+        }
+
+        bool is_identifier(const std::string & str)
+        {
+            if (str.empty() || std::isdigit(static_cast<unsigned char>(str.front())))
+                return false;
+            for (const auto ch: str)
+                if (!std::isalnum(static_cast<unsigned char>(ch)) && ch != '_')
+                    return false;
+            return true;
+        }
+
+    }
+
+    Result Dispatcher::from_recipe(Dispatcher & dispatcher, const model::Recipe & recipe)
+    {
+        MSS_BEGIN(Result);
+
+        dispatcher = Dispatcher();
+
+        //Only the key-values of the recipe itself count, dependents do not multiversion their sources
+        std::string isas, functions, sources;
+        recipe.each_key_value(LanguageTypePair(Language::Undefined, Type::Undefined), [&](const ingredient::KeyValue & kv) {
+            if (kv.owner() != &recipe || !kv.has_value())
+                return true;
+            if (false) {}
+            else if (kv.key() == "multiversion.isa")
+                isas = kv.value();
+            else if (kv.key() == "multiversion.functions")
+                functions = kv.value();
+            else if (kv.key() == "multiversion.header")
+                dispatcher.header_ = kv.value();
+            else if (kv.key() == "multiversion.sources")
+                sources = kv.value();
+            return true;
+        });
+
+        dispatcher.isas_ = split(isas);
+        if (dispatcher.isas_.empty())
+            MSS_RETURN_OK();
+
+        dispatcher.functions_ = split(functions);
+        MSG_MSS(!dispatcher.functions_.empty(), Error, "Recipe " << recipe.uri() << " is multiversioned, but does not specify its functions via multiversion.functions");
+        for (const auto & function: dispatcher.functions_)
+            MSG_MSS(is_identifier(function), Error, "Multiversioned function '" << function << "' of " << recipe.uri() << " is not an identifier");
+        MSG_MSS(!dispatcher.header_.empty(), Error, "Recipe " << recipe.uri() << " is multiversioned, but does not specify the header that declares its functions via multiversion.header");
+
+        //Compiling all sources per instruction set would define their other external symbols more than once
+        for (const auto & source: split(sources))
+            dispatcher.sources_.insert(source);
+        MSG_MSS(!dispatcher.sources_.empty(), Error, "Recipe " << recipe.uri() << " is multiversioned, but does not specify the sources that define its functions via multiversion.sources");
+        std::set<std::string> found;
+        for (const auto language: {Language::C, Language::CXX})
+        {
+            auto it = recipe.files().find(LanguageTypePair(language, Type::Source));
+            if (it == recipe.files().end())
+                continue;
+            for (const ingredient::File & source: it->second)
+            {
+                if (!dispatcher.is_selected(source))
+                    continue;
+                MSG_MSS(dispatcher.language_ == Language::Undefined || dispatcher.language_ == language, Error, "The multiversioned sources of " << recipe.uri() << " mix C and C++, the dispatcher can only be generated for one language");
+                dispatcher.language_ = language;
+                found.insert(source.rel().generic_string());
+            }
+        }
+        for (const auto & source: dispatcher.sources_)
+            MSG_MSS(found.count(source) > 0, Error, "Multiversioned source '" << source << "' is not a C or C++ source of " << recipe.uri());
+
+        MSS_END();
+    }
+
+    bool Dispatcher::is_selected(const ingredient::File & source) const
+    {
+        return sources_.count(source.rel().generic_string()) > 0;
+    }
+
+    std::string Dispatcher::suffix(const std::string & isa)
+    {
+        std::string res = isa;
+        for (auto & ch: res)
+            if (!std::isalnum(static_cast<unsigned char>(ch)))
+                ch = '_';
+        return res;
+    }
+
+    std::string Dispatcher::variant(const std::string & function, const std::string & isa) const
+    {
+        return function + "_" + suffix(isa);
+    }
+
+    std::string Dispatcher::default_variant(const std::string & function) const
+    {
+        return function + "_default";
+    }
+
+    void Dispatcher::stream(std::ostream & os) const
+    {
+        os << "/* Generated by cook, do not edit */" << std::endl;
+        os << "#include \"" << header_ << "\"" << std::endl;
+        os << std::endl;
+        os << "#ifdef __cplusplus" << std::endl;
+        os << "#define COOK_C_LINKAGE extern \"C\"" << std::endl;
+        os << "#else" << std::endl;
+        os << "#define COOK_C_LINKAGE" << std::endl;
+        os << "#endif" << std::endl;
+
+        for (const auto & function: functions_)
+        {
+            os << std::endl;
+            os << "__typeof__(" << function << ") " << default_variant(function);
+            for (const auto & isa: isas_)
+                os << ", " << variant(function, isa);
+            os << ";" << std::endl;
+
+            //The resolver runs before the constructors, the cpu information has to be initialized explicitly
+            const std::string resolver = "cook_resolve_" + function;
+            os << "COOK_C_LINKAGE __typeof__(" << function << ") * " << resolver << "(void);" << std::endl;
+            os << "COOK_C_LINKAGE __typeof__(" << function << ") * " << resolver << "(void)" << std::endl;
+            os << "{" << std::endl;
+            os << "    __builtin_cpu_init();" << std::endl;
+            for (auto it = isas_.rbegin(); it != isas_.rend(); ++it)
+                os << "    if (__builtin_cpu_supports(\"" << *it << "\")) return " << variant(function, *it) << ";" << std::endl;
+            os << "    return " << default_variant(function) << ";" << std::endl;
+            os << "}" << std::endl;
+            os << "__typeof__(" << function << ") " << function << " __attribute__((ifunc(\"" << resolver << "\")));" << std::endl;
+        }
+    }
+
+} } }
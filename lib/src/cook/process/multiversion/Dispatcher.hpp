@@ -0,0 +1,52 @@
+#ifndef HEADER_cook_process_multiversion_Dispatcher_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_multiversion_Dispatcher_hpp_ALREADY_INCLUDED
+
+#include "cook/model/Recipe.hpp"
+#include "cook/Result.hpp"
+#include <ostream>
+#include <string>
+#include <list>
+#include <set>
+
+namespace cook { namespace process { namespace multiversion {
+
+    //The selected sources of a recipe are compiled once per instruction set, with its functions renamed to "<function>_<isa>".
+    //Their default compilation renames them to "<function>_default". The generated dispatcher defines each function
+    //as an ifunc that selects the variant for the best instruction set the cpu supports, when the program is loaded.
+    //Other external symbols of the selected sources would be defined once per variant: they should only define the functions.
+    //A recipe asks for this via its own key-values:
+    // * multiversion.isa: the instruction sets, from low to high, e.g. "x86-64-v2 x86-64-v3 x86-64-v4"
+    // * multiversion.functions: the functions to dispatch
+    // * multiversion.header: the header that declares these functions, relative to an include path
+    // * multiversion.sources: the sources that define these functions, relative to their directory, all C or all C++
+    class Dispatcher
+    {
+    public:
+        static Result from_recipe(Dispatcher & dispatcher, const model::Recipe & recipe);
+
+        bool empty() const { return isas_.empty(); }
+        const std::list<std::string> & isas() const { return isas_; }
+        const std::list<std::string> & functions() const { return functions_; }
+        //The language of the selected sources, the dispatcher is compiled in this language too
+        Language language() const { return language_; }
+        bool is_selected(const ingredient::File & source) const;
+
+        //The suffix for the functions of the variant for an instruction set
+        static std::string suffix(const std::string & isa);
+        std::string variant(const std::string & function, const std::string & isa) const;
+        std::string default_variant(const std::string & function) const;
+
+        //Valid C and C++, using the gcc and clang builtins for the cpu detection
+        void stream(std::ostream & os) const;
+
+    private:
+        std::list<std::string> isas_;
+        std::list<std::string> functions_;
+        std::string header_;
+        std::set<std::string> sources_;
+        Language language_ = Language::Undefined;
+    };
+
+} } }
+
+#endif
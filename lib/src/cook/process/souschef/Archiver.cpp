@@ -3,6 +3,8 @@
 #include "cook/process/toolchain/Manager.hpp"
 #include "cook/util/File.hpp"
 #include "gubg/stream.hpp"
+#include <fstream>
+#include <sstream>
 
 namespace cook { namespace process { namespace souschef {
 
@@ -22,21 +24,34 @@ namespace cook { namespace process { namespace souschef {
             MSS_RETURN_OK();
         }
 
-        command::Ptr ac;
+        //Incremental updates are only used when the toolchain knows how to do them
+        bool incremental = false;
+        context.toolchain().each_config([&](const std::string & key, const std::string & value, bool resolved) {
+            if (key == "archive.update" && value == "incremental" && resolved)
+                incremental = true;
+        });
+
+        command::Archive::Ptr ac;
         MSS(archive_command_(ac, recipe, context));
+        ac->set_incremental(incremental);
         auto archive_vertex = g.add_vertex(ac);
 
+        std::set<std::string> members;
         for(const ingredient::File & object : objects)
         {
             auto ss = log::scope("object", [&](auto &node){node.attr("file", object);});
             const std::filesystem::path & obj_fn = object.key();
             MSS(g.add_edge(archive_vertex, g.goc_vertex(obj_fn)));
+            members.insert(obj_fn.string());
         }
 
         // get the library dir (local to the path)
         MSS(!!recipe.build_target().filename);
         std::filesystem::path lib_fn = context.dirs().output(true) / *recipe.build_target().filename;
 
+        if (incremental)
+            MSS(remove_stale_archive_(lib_fn, members, recipe, context));
+
         // add the link in the execution graph
         {
             MSS(g.add_edge(g.goc_vertex(lib_fn), archive_vertex));
@@ -84,7 +99,38 @@ namespace cook { namespace process { namespace souschef {
         MSS_END();
     }
 
-    Result Archiver::archive_command_(command::Ptr &ptr, model::Recipe & recipe, const Context & context) const
+    Result Archiver::remove_stale_archive_(const std::filesystem::path & lib_fn, const std::set<std::string> & members, const model::Recipe & recipe, const Context & context) const
+    {
+        MSS_BEGIN(Result);
+
+        //The members of the previous run: when one of them is gone, the archive would keep it
+        //forever when updated in place, so it is removed and created again from scratch
+        const std::filesystem::path members_fn = context.dirs().temporary(true) / recipe.uri().string(false) / "archive.members";
+        {
+            std::ifstream fi(members_fn, std::ios::binary);
+            std::string line;
+            bool is_stale = false;
+            while (!is_stale && std::getline(fi, line))
+                is_stale = !members.count(line);
+
+            if (is_stale)
+            {
+                std::error_code ec;
+                std::filesystem::remove(lib_fn, ec);
+                MSG_MSS(!ec, Error, "Could not remove stale archive " << lib_fn);
+                MSS_RC << MESSAGE(Info, "Removed " << lib_fn << ": objects were removed from " << recipe.uri());
+            }
+        }
+
+        std::ostringstream oss;
+        for (const auto & member: members)
+            oss << member << std::endl;
+        MSS(util::write_if_changed(members_fn, oss.str()));
+
+        MSS_END();
+    }
+
+    Result Archiver::archive_command_(command::Archive::Ptr &ptr, model::Recipe & recipe, const Context & context) const
     {
         MSS_BEGIN(Result);
 
@@ -2,7 +2,7 @@
 #define HEADER_cook_process_souschef_Archiver_hpp_ALREADY_INCLUDED
 
 #include "cook/process/souschef/Interface.hpp"
-#include "cook/process/command/Interface.hpp"
+#include "cook/process/command/Archive.hpp"
 #include <set>
 
 namespace cook { namespace process { namespace souschef {
@@ -14,7 +14,8 @@ public:
     Result process(model::Recipe & recipe, RecipeFilteredGraph & file_command_graph, const Context & context) const override;
 
 private:
-    Result archive_command_(command::Ptr &, model::Recipe & recipe, const Context & context) const;
+    Result archive_command_(command::Archive::Ptr &, model::Recipe & recipe, const Context & context) const;
+    Result remove_stale_archive_(const std::filesystem::path & lib_fn, const std::set<std::string> & members, const model::Recipe & recipe, const Context & context) const;
 };
 
 } } }
@@ -1,9 +1,15 @@
 #include "cook/process/souschef/Compiler.hpp"
 #include "cook/process/toolchain/Manager.hpp"
 #include "cook/process/command/Compile.hpp"
+#include "cook/process/command/Scan.hpp"
+#include "cook/process/command/Collate.hpp"
 #include "cook/util/File.hpp"
+#include "cook/util/HeaderMap.hpp"
+#include "cook/process/multiversion/Dispatcher.hpp"
 #include "cook/log/Scope.hpp"
 #include "gubg/hash/MD5.hpp"
+#include <set>
+#include <sstream>
 
 namespace cook { namespace process { namespace souschef {
 
@@ -22,48 +28,273 @@ namespace cook { namespace process { namespace souschef {
 
         const model::Recipe::Files & files = recipe.files();
 
-        recipe.each_file(LanguageTypePair(language_, Type::Header), [](auto &f) {
+        //Headers generated by a script recipe have to exist before anything is compiled
+        std::list<std::filesystem::path> generated_headers;
+        recipe.each_file(LanguageTypePair(language_, Type::Header), [&](auto &f) {
+            if (f.owner() != &recipe && f.content() == Content::Generated)
+                generated_headers.push_back(f.key());
             f.set_propagation(Propagation::Private);
             return true;
         });
 
+        //Sources generated by a script recipe are compiled by its dependents, they do not propagate any further
+        recipe.each_file(LanguageTypePair(language_, Type::Source), [&](auto &f) {
+            if (f.owner() != &recipe && f.content() == Content::Generated)
+                f.set_propagation(Propagation::Private);
+            return true;
+        });
+
         auto it = recipe.files().find(LanguageTypePair(language_, Type::Source));
         if (it == files.end() || it->second.empty())
             MSS_RETURN_OK();
         L("Found source files for " << language_);
 
-        command::Ptr cp;
+        command::Compile::Ptr cp;
         MSS(compile_command_(cp, recipe, context));
-    
+
+        //The header map resolves the headers known to cook without searching all include paths.
+        //It is only used when requested and when the toolchain knows how to pass it.
+        std::filesystem::path header_map_fn;
+        if (context.toolchain().has_config("header_map", "true") && !cp->get_kv_part(toolchain::Part::HeaderMap, "header_map").empty())
+        {
+            MSS(write_header_map_(header_map_fn, recipe, context));
+            cp->set_header_map(header_map_fn);
+        }
+
+        //C++20 modules: each source is scanned first, and the collated result completes the compile edges
+        const bool use_modules = (language_ == Language::CXX && context.toolchain().has_config("c++.modules", "true"));
+        command::Scan::Ptr sp;
+        std::filesystem::path dyndep_fn;
+        std::list<std::filesystem::path> module_infos, module_maps;
+        if (use_modules)
+        {
+            MSG_MSS(!!context.toolchain().element(toolchain::Element::Scan, language_, TargetType::Object), Error, "C++ modules are enabled, but the toolchain does not know how to scan " << language_ << " sources");
+            sp = context.toolchain().create_command<command::Scan>(toolchain::Element::Scan, language_, TargetType::Object, &recipe);
+            MSS(!!sp);
+
+            dyndep_fn = module_dyndep_(recipe, context);
+            cp->enable_module_map();
+            cp->set_dyndep(dyndep_fn);
+        }
+
+        //Split DWARF: the debug information is written to a .dwo file next to each object
+        const bool split_dwarf = (language_ != Language::ASM && language_ != Language::Resource
+                && context.toolchain().has_config("split_dwarf", "true") && context.toolchain().has_config("debug_symbols", "true"));
+
+        //Profile-guided optimization: the objects are compiled again when their profile changes
+        std::list<std::string> pgo_profiles;
+        if (context.toolchain().has_config("pgo", "use"))
+            pgo_profiles = context.toolchain().config_values("pgo.profile");
+
+        //Multiversioning: the selected sources are also compiled for each instruction set, with their functions renamed per variant.
+        //Only the compiler for the language of these sources handles them and generates the dispatcher.
+        multiversion::Dispatcher dispatcher;
+        if (language_ == Language::C || language_ == Language::CXX)
+            MSS(multiversion::Dispatcher::from_recipe(dispatcher, recipe));
+        std::list<std::pair<std::string, command::Compile::Ptr>> variants;
+        command::Compile::Ptr default_cp;
+        if (!dispatcher.empty() && dispatcher.language() == language_)
+        {
+            MSG_MSS(!use_modules, Error, "Recipe " << recipe.uri() << " cannot be multiversioned when C++ modules are used");
+            MSG_MSS(context.os() == OS::Linux, Error, "Recipe " << recipe.uri() << " cannot be multiversioned, the dispatcher needs ifunc support");
+
+            //The default compilation of the selected sources gets renamed functions too, the plain names are defined by the dispatcher
+            MSS(compile_command_(default_cp, recipe, context));
+            if (!header_map_fn.empty())
+                default_cp->set_header_map(header_map_fn);
+            auto rename = [&](command::Compile & compile, const std::function<std::string (const std::string &)> & variant)
+            {
+                for (const auto & function: dispatcher.functions())
+                    compile.process_ingredient(LanguageTypePair(Language::Undefined, Type::Define), ingredient::KeyValue(function, variant(function)));
+            };
+            rename(*default_cp, [&](const std::string & function) { return dispatcher.default_variant(function); });
+            for (const auto & isa: dispatcher.isas())
+            {
+                auto vcp = context.toolchain().create_command<command::Compile>(toolchain::Element::Compile, language_, TargetType::Object, &recipe, {{"march", isa}});
+                MSS(!!vcp);
+                if (!header_map_fn.empty())
+                    vcp->set_header_map(header_map_fn);
+                rename(*vcp, [&](const std::string & function) { return dispatcher.variant(function, isa); });
+                variants.emplace_back(multiversion::Dispatcher::suffix(isa), vcp);
+            }
+        }
 
         for (const ingredient::File & source : it->second)
         {
             MSG_MSS(source.propagation() == Propagation::Private, Warning, "Source file '" << source << "' in " << recipe.uri() << " has public propagation and will (probably) result into multiple defined symbols");
 
-            const ingredient::File object = construct_object_file(source, recipe, context);
-            auto ss = log::scope("Compiler::process", [&](auto &node){node.attr("source", source).attr("object", object);});
-            const LanguageTypePair key(Language::Binary, Type::Object);
+            const bool is_multiversioned = (!!default_cp && dispatcher.is_selected(source));
+            if (is_multiversioned)
+            {
+                for (const auto & p: variants)
+                {
+                    build::Graph::vertex_descriptor variant_vertex;
+                    MSS(add_compile_(variant_vertex, recipe, g, context, p.second, source, construct_object_file(source, recipe, context, p.first), header_map_fn, generated_headers, split_dwarf, pgo_profiles));
+                }
+            }
 
-            MSG_MSS(recipe.insert(key, object), Error, "Object file '" << object << "' already present in " << recipe.uri());
+            const ingredient::File object = construct_object_file(source, recipe, context);
+            build::Graph::vertex_descriptor compile_vertex;
+            MSS(add_compile_(compile_vertex, recipe, g, context, (is_multiversioned ? default_cp : cp), source, object, header_map_fn, generated_headers, split_dwarf, pgo_profiles));
 
-            L("Adding compile command");
-            auto compile_vertex = g.add_vertex(cp);
+            if (use_modules)
             {
-                const std::filesystem::path & src_fn = source.key();
-                auto source_vertex = g.goc_vertex(src_fn);
-                MSS(g.add_edge(compile_vertex, source_vertex));
-            } 
-            {
-                const std::filesystem::path & obj_fn = object.key();
-                auto object_vertex = g.goc_vertex(obj_fn);
-                MSS(g.add_edge(object_vertex, compile_vertex));
+                L("Adding scan command");
+                const ingredient::File module_info = construct_module_info_file(object, recipe);
+                MSG_MSS(recipe.insert(LanguageTypePair(language_, Type::ModuleInfo), module_info), Error, "Module information file '" << module_info << "' already present in " << recipe.uri());
+
+                auto scan_vertex = g.add_vertex(sp);
+                MSS(g.add_edge(scan_vertex, g.goc_vertex(source.key())));
+                MSS(g.add_edge(g.goc_vertex(module_info.key()), scan_vertex));
+                //The gcc scanner also writes the preprocessed source
+                if (module_format_(context) == "gcc")
+                    MSS(g.add_edge(g.goc_vertex(module_info.key() + ".i"), scan_vertex, RecipeFilteredGraph::Implicit));
+                module_infos.push_back(module_info.key());
+
+                //The module map is written by the collate command, the dyndep file tells ninja which modules are provided and required
+                const std::filesystem::path module_map_fn = object.key() + ".modmap";
+                MSS(g.add_edge(compile_vertex, g.goc_vertex(module_map_fn), RecipeFilteredGraph::Implicit));
+                MSS(g.add_edge(compile_vertex, g.goc_vertex(dyndep_fn), RecipeFilteredGraph::OrderOnly));
+                module_maps.push_back(module_map_fn);
             }
         }
 
+        if (use_modules)
+            MSS(add_collate_command_(recipe, g, context, dyndep_fn, module_infos, module_maps));
+
+        if (!!default_cp)
+        {
+            //The dispatcher is compiled with the plain function names
+            std::ostringstream oss;
+            dispatcher.stream(oss);
+            ingredient::File dispatcher_src(context.dirs().temporary(true) / recipe.uri().string(false), gubg::stream([&](auto & os) { os << "multiversion" << (language_ == Language::C ? ".c" : ".cpp"); }));
+            dispatcher_src.set_content(Content::Generated);
+            dispatcher_src.set_owner(&recipe);
+            MSS(util::write_if_changed(dispatcher_src.key(), oss.str()));
+            build::Graph::vertex_descriptor dispatcher_vertex;
+            MSS(add_compile_(dispatcher_vertex, recipe, g, context, cp, dispatcher_src, construct_object_file(dispatcher_src, recipe, context), header_map_fn, generated_headers, split_dwarf, pgo_profiles));
+        }
+
+        MSS_END();
+    }
+
+    Result Compiler::add_compile_(build::Graph::vertex_descriptor & compile_vertex, model::Recipe & recipe, RecipeFilteredGraph & g, const Context & context, command::Compile::Ptr cp, const ingredient::File & source, const ingredient::File & object, const std::filesystem::path & header_map_fn, const std::list<std::filesystem::path> & generated_headers, bool split_dwarf, const std::list<std::string> & pgo_profiles) const
+    {
+        MSS_BEGIN(Result);
+
+        auto ss = log::scope("Compiler::process", [&](auto &node){node.attr("source", source).attr("object", object);});
+        const LanguageTypePair key(Language::Binary, Type::Object);
+
+        MSG_MSS(recipe.insert(key, object), Error, "Object file '" << object << "' already present in " << recipe.uri());
+
+        L("Adding compile command");
+        compile_vertex = g.add_vertex(cp);
+        {
+            const std::filesystem::path & src_fn = source.key();
+            auto source_vertex = g.goc_vertex(src_fn);
+            MSS(g.add_edge(compile_vertex, source_vertex));
+        } 
+        {
+            const std::filesystem::path & obj_fn = object.key();
+            auto object_vertex = g.goc_vertex(obj_fn);
+            MSS(g.add_edge(object_vertex, compile_vertex));
+        }
+
+        for (const auto & profile: pgo_profiles)
+        {
+            //Objects without a profile were not run during the training, they do not depend on it
+            const std::filesystem::path profile_fn = pgo_profile_(profile, object.key());
+            std::error_code ec;
+            if (std::filesystem::exists(profile_fn, ec))
+                MSS(g.add_edge(compile_vertex, g.goc_vertex(profile_fn), RecipeFilteredGraph::Implicit));
+        }
+        if (split_dwarf)
+            MSS(g.add_edge(g.goc_vertex(std::filesystem::path(object.key()).replace_extension(".dwo")), compile_vertex, RecipeFilteredGraph::Implicit));
+        if (!header_map_fn.empty())
+            MSS(g.add_edge(compile_vertex, g.goc_vertex(header_map_fn), RecipeFilteredGraph::Implicit));
+        for (const auto & fn: generated_headers)
+            MSS(g.add_edge(compile_vertex, g.goc_vertex(fn), RecipeFilteredGraph::OrderOnly));
+
         MSS_END();
     }
 
-    ingredient::File Compiler::construct_object_file(const ingredient::File & source, model::Recipe & recipe, const Context & context) const
+    Result Compiler::add_collate_command_(model::Recipe & recipe, RecipeFilteredGraph & g, const Context & context, const std::filesystem::path & dyndep_fn, const std::list<std::filesystem::path> & module_infos, const std::list<std::filesystem::path> & module_maps) const
+    {
+        MSS_BEGIN(Result);
+
+        auto cp = std::make_shared<command::Collate>(context.executable(), module_format_(context), context.dirs().temporary(true) / "modules", recipe);
+
+        auto collate_vertex = g.add_vertex(cp);
+        MSS(g.add_edge(g.goc_vertex(dyndep_fn), collate_vertex));
+        for (const auto & fn: module_maps)
+            MSS(g.add_edge(g.goc_vertex(fn), collate_vertex, RecipeFilteredGraph::Implicit));
+        for (const auto & fn: module_infos)
+            MSS(g.add_edge(collate_vertex, g.goc_vertex(fn)));
+
+        //The module information of the dependencies is needed to find the modules they provide.
+        //Their dyndep files are waited for to make sure ninja knows which edges produce these modules.
+        std::list<std::filesystem::path> dependency_infos;
+        std::set<std::filesystem::path> dependency_dyndeps;
+        recipe.each_file(LanguageTypePair(language_, Type::ModuleInfo), [&](const ingredient::File & f) {
+            if (f.owner() == &recipe)
+                return true;
+            dependency_infos.push_back(f.key());
+            if (!!f.owner())
+                dependency_dyndeps.insert(module_dyndep_(*f.owner(), context));
+            return true;
+        });
+        for (const auto & fn: dependency_infos)
+        {
+            cp->add_module_info(fn);
+            MSS(g.add_edge(collate_vertex, g.goc_vertex(fn), RecipeFilteredGraph::Implicit));
+        }
+        for (const auto & fn: dependency_dyndeps)
+            MSS(g.add_edge(collate_vertex, g.goc_vertex(fn), RecipeFilteredGraph::OrderOnly));
+
+        MSS_END();
+    }
+
+    Result Compiler::write_header_map_(std::filesystem::path & fn, const model::Recipe & recipe, const Context & context) const
+    {
+        MSS_BEGIN(Result);
+
+        //All visible headers, both own and propagated, are spelled relative to their include path
+        util::HeaderMap header_map;
+        recipe.each_file([&](const LanguageTypePair & ltp, const ingredient::File & file) {
+            if (ltp.type == Type::Header && !file.rel().empty())
+                header_map.add(file.dir(), file.rel());
+            return true;
+        });
+
+        fn = context.dirs().temporary(true) / recipe.uri().string(false) / gubg::stream([&](auto & os) { os << "headers." << language_ << ".hmap"; });
+        MSS(util::write_if_changed(fn, header_map.serialize()));
+
+        MSS_END();
+    }
+
+    ingredient::File Compiler::construct_module_info_file(const ingredient::File & object, model::Recipe & recipe) const
+    {
+        ingredient::File module_info(object.dir(), object.rel().string() + ".ddi");
+        module_info.set_content(Content::Generated);
+        module_info.set_owner(&recipe);
+        module_info.set_overwrite(Overwrite::IfSame);
+        module_info.set_propagation(Propagation::Public);
+
+        return module_info;
+    }
+
+    std::string Compiler::module_format_(const Context & context) const
+    {
+        const auto formats = context.toolchain().config_values("c++.modules.format");
+        return (formats.empty() ? "gcc" : formats.back());
+    }
+
+    std::filesystem::path Compiler::module_dyndep_(const model::Recipe & recipe, const Context & context) const
+    {
+        return context.dirs().temporary(true) / recipe.uri().string(false) / "modules.dd";
+    }
+
+    ingredient::File Compiler::construct_object_file(const ingredient::File & source, model::Recipe & recipe, const Context & context, const std::string & variant) const
     {
         auto tmp_path = context.dirs().temporary(true);
 
@@ -74,6 +305,9 @@ namespace cook { namespace process { namespace souschef {
             s << source.dir().string();
             dir /= s.hash_hex();
         }
+        //Each multiversioning variant has its own object directory
+        if (!variant.empty())
+            dir /= variant;
 
         const std::filesystem::path rel = context.toolchain().intermediary_name(source.rel(), LanguageTypePair(language_, Type::Source), LanguageTypePair(Language::Binary, Type::Object), process::toolchain::Element::Compile);
 
@@ -86,7 +320,17 @@ namespace cook { namespace process { namespace souschef {
         return object;
     }
     
-    Result Compiler::compile_command_(command::Ptr &ptr, model::Recipe & recipe, const Context & context) const
+    std::filesystem::path Compiler::pgo_profile_(const std::string & profile, const std::filesystem::path & object)
+    {
+        const std::string placeholder = "{object}";
+        std::string fn = profile;
+        const auto ix = fn.find(placeholder);
+        if (ix != std::string::npos)
+            fn.replace(ix, placeholder.size(), std::filesystem::path(object).replace_extension("").relative_path().generic_string());
+        return std::filesystem::path(fn).lexically_normal();
+    }
+
+    Result Compiler::compile_command_(command::Compile::Ptr &ptr, model::Recipe & recipe, const Context & context) const
     {
         MSS_BEGIN(Result);
         
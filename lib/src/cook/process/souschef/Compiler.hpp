@@ -2,7 +2,7 @@
 #define HEADER_cook_process_souschef_Compiler_hpp_ALREADY_INCLUDED
 
 #include "cook/process/souschef/Interface.hpp"
-#include "cook/process/command/Interface.hpp"
+#include "cook/process/command/Compile.hpp"
 #include "cook/process/toolchain/Element.hpp"
 #include "gubg/stream.hpp"
 
@@ -17,8 +17,17 @@ public:
     Result process(model::Recipe & recipe, RecipeFilteredGraph & file_command_graph, const Context & context) const override;
 
 private:
-    ingredient::File construct_object_file(const ingredient::File & source, model::Recipe &recipe, const Context &context) const;
-    Result compile_command_(command::Ptr &, model::Recipe & recipe, const Context & context) const;
+    ingredient::File construct_object_file(const ingredient::File & source, model::Recipe &recipe, const Context &context, const std::string & variant = std::string()) const;
+    ingredient::File construct_module_info_file(const ingredient::File & object, model::Recipe &recipe) const;
+    Result add_compile_(build::Graph::vertex_descriptor & compile_vertex, model::Recipe & recipe, RecipeFilteredGraph & g, const Context & context, command::Compile::Ptr cp, const ingredient::File & source, const ingredient::File & object, const std::filesystem::path & header_map_fn, const std::list<std::filesystem::path> & generated_headers, bool split_dwarf, const std::list<std::string> & pgo_profiles) const;
+    Result compile_command_(command::Compile::Ptr &, model::Recipe & recipe, const Context & context) const;
+    Result write_header_map_(std::filesystem::path & fn, const model::Recipe & recipe, const Context & context) const;
+    Result add_collate_command_(model::Recipe & recipe, RecipeFilteredGraph & g, const Context & context, const std::filesystem::path & dyndep_fn, const std::list<std::filesystem::path> & module_infos, const std::list<std::filesystem::path> & module_maps) const;
+    std::filesystem::path module_dyndep_(const model::Recipe & recipe, const Context & context) const;
+    //The flavour of the module maps and the scanner output, "gcc" or "clang"
+    std::string module_format_(const Context & context) const;
+    //The profile of an object, "{object}" in the profile stands for the object without its extension
+    static std::filesystem::path pgo_profile_(const std::string & profile, const std::filesystem::path & object);
 
     Language language_;
 };
@@ -5,6 +5,18 @@ namespace cook { namespace process { namespace souschef {
 
 namespace  {
 
+//The toolchain options a recipe sets itself take precedence over the ones its dependencies propagate
+bool is_overridden_(const model::Recipe &, const LanguageTypePair &, const ingredient::File &)
+{
+    return false;
+}
+bool is_overridden_(const model::Recipe & dst_recipe, const LanguageTypePair & key, const ingredient::KeyValue & key_value)
+{
+    if (key.type != Type::ToolchainOption)
+        return false;
+    const auto * own = dst_recipe.key_values().find(key, key_value.key());
+    return own && own->owner() == &dst_recipe;
+}
 
 template <typename Tag, typename Functor, typename Transformer>
 Result merge_(const model::Recipe & src_recipe, model::Recipe & dst_recipe, const DependentPropagator::SelectionFunction & selection, Functor && functor, Transformer && transform, Tag tag)
@@ -17,7 +29,7 @@ Result merge_(const model::Recipe & src_recipe, model::Recipe & dst_recipe, cons
     {
         MSS_BEGIN(Result);
 
-        if (ingredient.propagation() == Propagation::Public && selection(key))
+        if (ingredient.propagation() == Propagation::Public && selection(key) && !is_overridden_(dst_recipe, key, ingredient))
         {
             if (!functor || functor(key, ingredient))
                 MSS(dst_recipe.insert_or_merge(key, transform(ingredient)));
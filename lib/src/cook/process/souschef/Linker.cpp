@@ -1,8 +1,10 @@
 #include "cook/process/souschef/Linker.hpp"
 #include "cook/process/toolchain/Manager.hpp"
 #include "cook/process/command/Link.hpp"
+#include "cook/process/command/PostLink.hpp"
 #include "cook/util/File.hpp"
 #include "gubg/stream.hpp"
+#include <optional>
 
 namespace cook { namespace process { namespace souschef {
 
@@ -28,30 +30,38 @@ namespace cook { namespace process { namespace souschef {
         // make the link vertex
         build::Graph::vertex_descriptor link_vertex;
         {
-            command::Ptr lc;
+            command::Link::Ptr lc;
             MSS(link_command_(lc, recipe, context));
             link_vertex = g.add_vertex(lc);
         }
 
-        // link the objects
-        for(const ingredient::File & object : objects)
+        auto add_link_inputs = [&](build::Graph::vertex_descriptor vertex)
         {
-            auto ss = log::scope("object", [&](auto &node){node.attr("file", object);});
-            const std::filesystem::path & obj_fn = object.key();
-            MSS(g.add_edge(link_vertex, g.goc_vertex(obj_fn)));
-        }
+            MSS_BEGIN(Result);
 
-        // link the dependencies
-        for(const ingredient::File & dep : deps)
-        {
-            const std::filesystem::path &fn = dep.key();
-            MSS(g.add_edge(link_vertex, g.goc_vertex(fn), RecipeFilteredGraph::Implicit));
-        }
-        for(const ingredient::File & exp : exports)
-        {
-            const std::filesystem::path & fn = exp.key();
-            MSS(g.add_edge(link_vertex, g.goc_vertex(fn), RecipeFilteredGraph::Implicit));
-        }
+            // link the objects
+            for(const ingredient::File & object : objects)
+            {
+                auto ss = log::scope("object", [&](auto &node){node.attr("file", object);});
+                const std::filesystem::path & obj_fn = object.key();
+                MSS(g.add_edge(vertex, g.goc_vertex(obj_fn)));
+            }
+
+            // link the dependencies
+            for(const ingredient::File & dep : deps)
+            {
+                const std::filesystem::path &fn = dep.key();
+                MSS(g.add_edge(vertex, g.goc_vertex(fn), RecipeFilteredGraph::Implicit));
+            }
+            for(const ingredient::File & exp : exports)
+            {
+                const std::filesystem::path & fn = exp.key();
+                MSS(g.add_edge(vertex, g.goc_vertex(fn), RecipeFilteredGraph::Implicit));
+            }
+
+            MSS_END();
+        };
+        MSS(add_link_inputs(link_vertex));
 
 
         // create the local link dir
@@ -124,7 +134,62 @@ namespace cook { namespace process { namespace souschef {
             // add the link in the execution graph
             {
                 const std::filesystem::path & lib_fn = context.dirs().output(true) / *recipe.build_target().filename;
-                MSS(g.add_edge(g.goc_vertex(lib_fn), link_vertex));
+
+                PostLinkOptimization post_link;
+                if (recipe.build_target().type == TargetType::Executable)
+                    MSS(post_link_(post_link, recipe, context));
+
+                switch (post_link.mode)
+                {
+                    case PostLinkOptimization::None:
+                        MSS(g.add_edge(g.goc_vertex(lib_fn), link_vertex));
+                        break;
+
+                    case PostLinkOptimization::Bolt:
+                        {
+                            //The link writes the executable BOLT starts from
+                            const std::filesystem::path prelink_fn = lib_fn.string() + ".prebolt";
+                            MSS(g.add_edge(g.goc_vertex(prelink_fn), link_vertex));
+
+                            auto bolt = std::make_shared<command::PostLink>(post_link.bolt, "-o ", recipe);
+                            for (const auto & arg: {"-reorder-blocks=ext-tsp", "-reorder-functions=cdsort", "-split-functions", "-split-all-cold", "-icf=1"})
+                                bolt->add_argument(arg);
+                            bolt->add_argument("-data=", post_link.profile);
+                            auto bolt_vertex = g.add_vertex(bolt);
+                            MSS(g.add_edge(bolt_vertex, g.goc_vertex(prelink_fn)));
+                            MSS(g.add_edge(bolt_vertex, g.goc_vertex(post_link.profile), RecipeFilteredGraph::Implicit));
+                            MSS(g.add_edge(g.goc_vertex(lib_fn), bolt_vertex));
+                        }
+                        break;
+
+                    case PostLinkOptimization::SymbolOrder:
+                        {
+                            //BOLT derives the function order from the profile and a first link, the final link places the functions in that order
+                            const std::filesystem::path prelink_fn = lib_fn.string() + ".prelink";
+                            const std::filesystem::path order_fn = lib_fn.string() + ".order";
+                            const std::filesystem::path unused_fn = lib_fn.string() + ".order.bolt";
+                            MSS(g.add_edge(g.goc_vertex(prelink_fn), link_vertex));
+
+                            auto order = std::make_shared<command::PostLink>(post_link.bolt, "-generate-function-order=", recipe);
+                            order->add_argument("-reorder-functions=cdsort");
+                            order->add_argument("-data=", post_link.profile);
+                            order->add_argument("-o ", unused_fn);
+                            auto order_vertex = g.add_vertex(order);
+                            MSS(g.add_edge(order_vertex, g.goc_vertex(prelink_fn)));
+                            MSS(g.add_edge(order_vertex, g.goc_vertex(post_link.profile), RecipeFilteredGraph::Implicit));
+                            MSS(g.add_edge(g.goc_vertex(order_fn), order_vertex));
+                            MSS(g.add_edge(g.goc_vertex(unused_fn), order_vertex, RecipeFilteredGraph::Implicit));
+
+                            command::Link::Ptr lc;
+                            MSS(link_command_(lc, recipe, context));
+                            lc->add_symbol_ordering_file(post_link.order_option, order_fn);
+                            auto ordered_link_vertex = g.add_vertex(lc);
+                            MSS(add_link_inputs(ordered_link_vertex));
+                            MSS(g.add_edge(ordered_link_vertex, g.goc_vertex(order_fn), RecipeFilteredGraph::Implicit));
+                            MSS(g.add_edge(g.goc_vertex(lib_fn), ordered_link_vertex));
+                        }
+                        break;
+                }
             }
         }
 
@@ -145,7 +210,7 @@ namespace cook { namespace process { namespace souschef {
         return link;
     }
 
-    Result Linker::link_command_(command::Ptr &ptr, model::Recipe & recipe, const Context & context) const
+    Result Linker::link_command_(command::Link::Ptr &ptr, model::Recipe & recipe, const Context & context) const
     {
         MSS_BEGIN(Result);
 
@@ -154,4 +219,51 @@ namespace cook { namespace process { namespace souschef {
         MSS_END();
     }
 
+    Result Linker::post_link_(PostLinkOptimization & post_link, const model::Recipe & recipe, const Context & context) const
+    {
+        MSS_BEGIN(Result);
+
+        const auto & toolchain = context.toolchain();
+        const auto overrides = toolchain::Manager::overrides(recipe);
+        auto option = [&](const std::string & key)
+        {
+            auto it = overrides.find(key);
+            return it == overrides.end() ? std::optional<std::string>() : std::optional<std::string>(it->second);
+        };
+
+        //A globally configured post-link optimization does not apply, the executable has to opt in
+        const auto mode = option("post_link");
+        if (!mode)
+            MSS_RETURN_OK();
+
+        if (false) {}
+        else if (*mode == "bolt")
+            post_link.mode = PostLinkOptimization::Bolt;
+        else if (*mode == "symbol_order")
+            post_link.mode = PostLinkOptimization::SymbolOrder;
+        else
+            MSG_MSS(false, Error, "Unknown post-link optimization '" << *mode << "' for " << recipe.uri() << ", use bolt or symbol_order");
+
+        //A relative profile is found from the recipe
+        const auto profile = option("post_link.profile");
+        MSG_MSS(!!profile, Error, "The post-link optimization of " << recipe.uri() << " needs a recorded profile, set it via post_link.profile");
+        post_link.profile = std::filesystem::absolute(recipe.working_directory() / *profile).lexically_normal();
+        MSG_MSS(std::filesystem::exists(post_link.profile), Error, "The post-link profile " << post_link.profile << " of " << recipe.uri() << " does not exist");
+
+        //The BOLT executable is the same for all recipes, unless one sets its own
+        if (const auto bolt = option("post_link.bolt"))
+            post_link.bolt = *bolt;
+        else if (const auto bolts = toolchain.config_values("post_link.bolt"); !bolts.empty())
+            post_link.bolt = bolts.front();
+
+        if (post_link.mode == PostLinkOptimization::SymbolOrder)
+        {
+            const auto options = toolchain.config_values("post_link.order_option", recipe);
+            MSG_MSS(!options.empty(), Error, "The toolchain does not support linking with a symbol ordering file");
+            post_link.order_option = options.front();
+        }
+
+        MSS_END();
+    }
+
 } } }
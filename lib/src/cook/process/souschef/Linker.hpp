@@ -2,7 +2,7 @@
 #define HEADER_cook_process_souschef_Linker_hpp_ALREADY_INCLUDED
 
 #include "cook/process/souschef/Interface.hpp"
-#include "cook/process/command/Interface.hpp"
+#include "cook/process/command/Link.hpp"
 #include <set>
 
 namespace cook { namespace process { namespace souschef {
@@ -15,7 +15,19 @@ public:
 
 private:
     virtual ingredient::File construct_link_file(model::Recipe & recipe, const Context &context) const;
-    Result link_command_(command::Ptr &, model::Recipe &recipe, const Context & context) const;
+    Result link_command_(command::Link::Ptr &, model::Recipe &recipe, const Context & context) const;
+
+    //The optional optimization of an executable after it is linked. Each executable opts in via its own
+    //toolchain options "post_link" and "post_link.profile", as a single profile only fits a single program.
+    struct PostLinkOptimization
+    {
+        enum Mode {None, Bolt, SymbolOrder};
+        Mode mode = None;
+        std::filesystem::path profile;
+        std::string bolt = "llvm-bolt";
+        std::string order_option;
+    };
+    Result post_link_(PostLinkOptimization &, const model::Recipe & recipe, const Context & context) const;
 };
 
 } } }
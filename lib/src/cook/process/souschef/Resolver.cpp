@@ -77,7 +77,18 @@ Result Resolver::process_one(model::Recipe & recipe, const model::GlobInfo & glo
     };
 
     std::string regex = glob_to_regex_(globber.pattern);
-    MSS(util::recurse_all_files(dir, regex, cb));
+
+    //Each directory is walked only once, also when the recipes are processed again for another configuration
+    const auto walk = std::make_pair(dir, regex);
+    auto it = matches_.find(walk);
+    if (it == matches_.end())
+    {
+        std::list<std::filesystem::path> matches;
+        MSS(util::recurse_all_files(dir, regex, [&](const std::filesystem::path & fn) { matches.push_back(fn); return true; }));
+        it = matches_.emplace(walk, std::move(matches)).first;
+    }
+    for (const auto & fn: it->second)
+        MSS(cb(fn));
 
 
     MSG_MSS(count > 0, Warning, "No file match expression '" << globber.dir << "/" << globber.pattern << "'");
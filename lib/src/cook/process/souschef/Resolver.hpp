@@ -5,6 +5,8 @@
 #include "cook/rules/RuleSet.hpp"
 #include "cook/model/GlobInfo.hpp"
 #include "cook/ingredient/File.hpp"
+#include <map>
+#include <list>
 
 namespace cook { namespace process { namespace souschef { 
 
@@ -26,6 +28,7 @@ namespace cook { namespace process { namespace souschef {
         std::string glob_to_regex_(const std::string & pattern) const;
 
         rules::RuleSet::Ptr rule_set_;
+        mutable std::map<std::pair<std::filesystem::path, std::string>, std::list<std::filesystem::path>> matches_;
     };
 
 } } }
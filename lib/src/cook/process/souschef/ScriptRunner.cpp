@@ -1,15 +1,92 @@
 #include "cook/process/souschef/ScriptRunner.hpp"
+#include "cook/process/command/Script.hpp"
+#include "cook/log/Scope.hpp"
 #include <cstdlib>
 #include "cook/Result.hpp"
 
 namespace cook { namespace process { namespace souschef {
 
-    Result ScriptRunner::process(model::Recipe &recipe, RecipeFilteredGraph & /*file_command_graph*/, const Context &context) const
+    namespace {
+
+        bool is_output(const model::Recipe & recipe, const ingredient::File & file)
+        {
+            return file.owner() == &recipe && file.content() == Content::Generated;
+        }
+
+    }
+
+    Result ScriptRunner::process(model::Recipe &recipe, RecipeFilteredGraph & file_command_graph, const Context &context) const
     {
         MSS_BEGIN(Result, "");
 
         MSS(recipe.build_target().type == TargetType::Script);
 
+        bool has_outputs = false;
+        recipe.each_file([&](const LanguageTypePair & ltp, const ingredient::File & file) {
+            has_outputs = has_outputs || is_output(recipe, file);
+            return true;
+        });
+        if (!has_outputs)
+        {
+            MSS(execute_(recipe));
+            MSS_RETURN_OK();
+        }
+
+        MSS(resolve_outputs_(recipe));
+
+        auto sp = std::make_shared<command::Script>(std::filesystem::current_path(), recipe);
+        unsigned int nr_commands = 0;
+        MSS(recipe.each_key_value(LanguageTypePair(Language::Script, Type::Executable), [&](auto &cmd) {
+            cmd.set_propagation(Propagation::Private);
+            sp->add_command(cmd.key());
+            ++nr_commands;
+            return true;
+        }));
+        MSG_MSS(nr_commands > 0, Error, "Script recipe " << recipe.uri() << " declares outputs, but has no commands to run");
+
+        auto & g = file_command_graph;
+        auto script_vertex = g.add_vertex(sp);
+
+        //Own files are the inputs, the outputs of other scripts and the build targets of the dependencies are waited for
+        MSS(recipe.each_file([&](const LanguageTypePair & ltp, const ingredient::File & file) {
+            MSS_BEGIN(Result);
+            if (false) {}
+            else if (is_output(recipe, file))
+                MSS(g.add_edge(g.goc_vertex(file.key()), script_vertex));
+            else if (file.owner() == &recipe)
+                MSS(g.add_edge(script_vertex, g.goc_vertex(file.key())));
+            else if (file.content() == Content::Generated && !!file.owner() && file.owner()->build_target().type == TargetType::Script)
+                MSS(g.add_edge(script_vertex, g.goc_vertex(file.key()), RecipeFilteredGraph::Implicit));
+            MSS_END();
+        }));
+
+        for (const auto & p: recipe.dependency_pairs())
+        {
+            const model::Recipe * dependency = p.second.recipe;
+            if (!dependency || !dependency->build_target().filename)
+                continue;
+
+            switch (dependency->build_target().type)
+            {
+                case TargetType::Archive:
+                case TargetType::SharedLibrary:
+                case TargetType::Plugin:
+                case TargetType::Executable:
+                    MSS(g.add_edge(script_vertex, g.goc_vertex(context.dirs().output(true) / *dependency->build_target().filename), RecipeFilteredGraph::Implicit));
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        MSS_END();
+    }
+
+    Result ScriptRunner::execute_(model::Recipe & recipe) const
+    {
+        MSS_BEGIN(Result, "");
+
         MSS(recipe.each_key_value(LanguageTypePair(Language::Script, Type::Executable), [=](auto &cmd) {
             MSS_BEGIN(Result, "");
             cmd.set_propagation(Propagation::Private);
@@ -26,4 +103,34 @@ namespace cook { namespace process { namespace souschef {
         MSS_END();
     }
 
+    Result ScriptRunner::resolve_outputs_(model::Recipe & recipe) const
+    {
+        MSS_BEGIN(Result);
+
+        //Outputs without language or type are resolved from their extension, as is done for globbed files
+        std::list<std::pair<LanguageTypePair, ingredient::File>> unresolved;
+        recipe.each_file([&](const LanguageTypePair & ltp, const ingredient::File & file) {
+            if (is_output(recipe, file) && ltp.language == Language::Undefined)
+                unresolved.emplace_back(ltp, file);
+            return true;
+        });
+
+        for (auto & p: unresolved)
+        {
+            recipe.erase(p.first, p.second);
+
+            LanguageTypePair key = p.first;
+            ingredient::File file = p.second;
+            const Propagation propagation = file.propagation();
+
+            auto accepts = [&](const rules::Interface & interface) { return interface.accepts_file(key, file); };
+            const rules::Interface & interface = rule_set_->find(accepts);
+            MSS(interface.resolve_file(key, file));
+            file.set_propagation(propagation);
+            MSS(interface.add_file(recipe, key, file));
+        }
+
+        MSS_END();
+    }
+
 }}}
@@ -2,19 +2,26 @@
 #define HEADER_cook_process_souschef_ScriptRunner_hpp_ALREADY_INCLUDED
 
 #include "cook/process/souschef/Interface.hpp"
+#include "cook/rules/RuleSet.hpp"
 
 namespace cook { namespace process { namespace souschef {
 
+//A script recipe that declares its outputs becomes a command in the build graph, its outputs are
+//propagated to the dependent recipes. Without declared outputs, the script is executed immediately.
 class ScriptRunner : public Interface
 {
 public:
-    ScriptRunner(bool do_execute): do_execute_(do_execute) {}
+    ScriptRunner(bool do_execute, const rules::RuleSet::Ptr & rule_set): do_execute_(do_execute), rule_set_(rule_set) {}
 
     Result process(model::Recipe & recipe, RecipeFilteredGraph & file_command_graph, const Context & context) const override;
     std::string description() const override { return "scriptrunner"; }
 
 private:
+    Result execute_(model::Recipe & recipe) const;
+    Result resolve_outputs_(model::Recipe & recipe) const;
+
     const bool do_execute_;
+    rules::RuleSet::Ptr rule_set_;
 };
 
 } } }
@@ -27,9 +27,19 @@ namespace cook { namespace process { namespace toolchain {
         auto s = log::scope("Configuration value", [&](auto & n){
             n.attr("key", key).attr("value", value);
         });
+        auto it = fixed_.find(key);
+        if (it != fixed_.end() && it->second != value)
+            return;
         config_.insert(std::make_pair(ConfigPair(key, value), New));
     }
 
+    void ConfigurationBoard::fix_configuration(const std::string & key, const std::string & value)
+    {
+        remove_config(key);
+        fixed_[key] = value;
+        add_configuration(key, value);
+    }
+
     bool ConfigurationBoard::add_callback(const Configuration & config)
     {
         return config_cbs_.insert(config).second;
@@ -42,6 +42,8 @@ namespace cook { namespace process { namespace toolchain {
 
         void add_configuration(const std::string & key, const std::string & value);
         void add_configuration(const std::string & key);
+        //The key only keeps this value, also when a callback adds another value for it later on
+        void fix_configuration(const std::string & key, const std::string & value);
 
         template <typename It>
         bool process(It first, It second)
@@ -95,6 +97,7 @@ namespace cook { namespace process { namespace toolchain {
 
         std::set<Configuration> config_cbs_;
         std::map<ConfigPair, State> config_;
+        std::map<std::string, std::string> fixed_;
     };
 
 } } }
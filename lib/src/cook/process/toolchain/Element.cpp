@@ -70,6 +70,7 @@ namespace cook { namespace process { namespace toolchain {
             L_CASE(Archive);
             L_CASE(Compile);
             L_CASE(Link);
+            L_CASE(Scan);
             L_CASE(UserDefined);
 #undef L_CASE
             default:
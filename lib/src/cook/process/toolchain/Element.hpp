@@ -19,6 +19,7 @@ namespace cook { namespace process { namespace toolchain {
                 Archive,
                 Compile,
                 Link,
+                Scan,
                 UserDefined,
             };
 
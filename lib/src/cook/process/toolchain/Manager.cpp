@@ -139,6 +139,79 @@ namespace cook { namespace process { namespace toolchain {
         return e;
     }
 
+    //The recipe's own options are kept when its dependencies propagate the same key, see DependentPropagator
+    Manager::Overrides Manager::overrides(const model::Recipe & recipe)
+    {
+        Overrides overrides;
+        recipe.each_key_value(LanguageTypePair(Language::Undefined, Type::ToolchainOption), [&](const ingredient::KeyValue & kv) {
+            overrides[kv.key()] = (kv.has_value() ? kv.value() : std::string("true"));
+            return true;
+        });
+        return overrides;
+    }
+
+    Element::Ptr Manager::recipe_element_(Element::Type element_type, Language language, TargetType target_type, const model::Recipe * recipe, const Overrides & extra_overrides) const
+    {
+        Overrides recipe_overrides = (recipe ? overrides(*recipe) : Overrides());
+        for (const auto & p: extra_overrides)
+            recipe_overrides[p.first] = p.second;
+        if (recipe_overrides.empty() || !pristine_board_)
+            return clone_(element_type, language, target_type);
+
+        std::lock_guard<std::mutex> lock(override_elements_mutex_);
+        const auto & elements = resolution_(recipe_overrides).elements;
+        auto eit = elements.find(Key(element_type, language, target_type));
+        return eit == elements.end() ? Element::Ptr() : std::make_shared<Element>(*eit->second);
+    }
+
+    std::list<std::string> Manager::config_values(const std::string & key, const model::Recipe & recipe) const
+    {
+        const Overrides recipe_overrides = overrides(recipe);
+        if (recipe_overrides.empty() || !pristine_board_)
+            return config_values(key);
+
+        std::lock_guard<std::mutex> lock(override_elements_mutex_);
+        return resolution_(recipe_overrides).board.config_values(key);
+    }
+
+    const Manager::Resolution & Manager::resolution_(const Overrides & overrides) const
+    {
+        //Each distinct set of overrides is resolved only once
+        auto it = override_elements_.find(overrides);
+        if (it == override_elements_.end())
+            it = override_elements_.emplace(overrides, resolve_overrides_(overrides)).first;
+        return it->second;
+    }
+
+    Manager::Resolution Manager::resolve_overrides_(const Overrides & overrides) const
+    {
+        auto ss = log::scope("resolve overrides");
+
+        Resolution resolution{*pristine_board_, Elements()};
+        auto & board = resolution.board;
+        for (const auto & p: configuration_)
+            board.fix_configuration(p.first, p.second);
+        for (const auto & p: overrides)
+            board.fix_configuration(p.first, p.second);
+
+        auto & elements = resolution.elements;
+        for (const auto & p: pristine_elements_)
+            elements[p.first] = std::make_shared<Element>(*p.second);
+
+        auto first = gubg::iterator::transform(elements.begin(), util::ElementAt<1>());
+        auto last = gubg::iterator::transform(elements.end(), util::ElementAt<1>());
+        while (board.process(first, last))
+            ;;
+
+        return resolution;
+    }
+
+    void Manager::clear_override_elements_()
+    {
+        std::lock_guard<std::mutex> lock(override_elements_mutex_);
+        override_elements_.clear();
+    }
+
     Element::Ptr Manager::goc_element(Element::Type type, Language language, TargetType target_type)
     {
         Key k(type, language, target_type);
@@ -153,14 +226,17 @@ namespace cook { namespace process { namespace toolchain {
 
     void Manager::add_config(const std::string & value)
     {
-        board_.add_configuration(value);
-        if (is_initialized())
-            resolve_();
+        add_config(value, "true");
     }
 
     void Manager::add_config(const std::string & key, const std::string & value)
     {
         board_.add_configuration(key, value);
+        if (pristine_board_)
+        {
+            pristine_board_->add_configuration(key, value);
+            clear_override_elements_();
+        }
         if (is_initialized())
             resolve_();
     }
@@ -193,12 +269,41 @@ namespace cook { namespace process { namespace toolchain {
 
         MSG_MSS(!is_initialized(), InternalError, "Manager Initialize multiple calls");
 
+        pristine_board_ = std::make_shared<ConfigurationBoard>(board_);
+        for (const auto & p: elements_)
+            pristine_elements_[p.first] = std::make_shared<Element>(*p.second);
+
         MSS(resolve_());
         initialized_ = true;
 
         MSS_END();
     }
 
+    Result Manager::set_configuration(const Overrides & configuration)
+    {
+        MSS_BEGIN(Result);
+
+        MSG_MSS(is_initialized(), InternalError, "A configuration can only be selected for an initialized toolchain");
+
+        auto ss = log::scope("set configuration");
+
+        configuration_ = configuration;
+        clear_override_elements_();
+
+        //Resolve again, starting from the configuration and the elements before resolution
+        board_ = *pristine_board_;
+        for (const auto & p: configuration_)
+            board_.fix_configuration(p.first, p.second);
+
+        elements_.clear();
+        for (const auto & p: pristine_elements_)
+            elements_[p.first] = std::make_shared<Element>(*p.second);
+
+        MSS(resolve_());
+
+        MSS_END();
+    }
+
     bool Manager::has_config(const std::string & key, const std::string & value) const
     {
         return board_.has_config(key, value);
@@ -210,10 +315,20 @@ namespace cook { namespace process { namespace toolchain {
 
     bool Manager::remove_config(const std::string & key, const std::string & value)
     {
+        if (pristine_board_)
+        {
+            pristine_board_->remove_config(key, value);
+            clear_override_elements_();
+        }
         return board_.remove_config(key, value);
     }
     bool Manager::remove_config(const std::string & key)
     {
+        if (pristine_board_)
+        {
+            pristine_board_->remove_config(key);
+            clear_override_elements_();
+        }
         return board_.remove_config(key);
     }
 
@@ -269,6 +384,14 @@ namespace cook { namespace process { namespace toolchain {
         board_.each_config(lambda);
     }
 
+    Probe & Manager::probe(const std::string & compiler, const std::filesystem::path & cache_dir)
+    {
+        auto & ptr = probes_[compiler];
+        if (!ptr)
+            ptr = std::make_shared<Probe>(compiler, cache_dir);
+        return *ptr;
+    }
+
     const Manager::NameFunctor & Manager::primary_target_functor() const
     {
         return primary_target_functor_;
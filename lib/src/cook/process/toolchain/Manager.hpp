@@ -4,11 +4,13 @@
 #include "cook/Language.hpp"
 #include "cook/process/toolchain/Element.hpp"
 #include "cook/process/toolchain/Configuration.hpp"
+#include "cook/process/toolchain/Probe.hpp"
 #include "cook/process//command/Interface.hpp"
 #include "cook/TargetType.hpp"
 #include "cook/Result.hpp"
 #include "cook/model/Recipe.hpp"
 #include <map>
+#include <mutex>
 
 namespace cook { namespace process { namespace toolchain { 
 
@@ -18,6 +20,8 @@ namespace cook { namespace process { namespace toolchain {
         using NameFunctor = std::function<std::filesystem::path (const model::Recipe &)>;
         using IntermediaryName = std::function<std::filesystem::path (const std::filesystem::path &, const LanguageTypePair &, const LanguageTypePair, Element::Type)>;
         using CommandConfigurationFunctor = std::function<void (Element::Ptr , model::Recipe *)>;
+        //The toolchain options a recipe sets for its own commands, they replace the global values for the same key
+        using Overrides = std::map<std::string, std::string>;
         
         Manager();
 
@@ -34,10 +38,11 @@ namespace cook { namespace process { namespace toolchain {
         void each_config(const std::function<void (const std::string &, const std::string &)> &cb) const;
         void each_config(const std::function<void (const std::string &, const std::string &, bool resolved)> &cb) const;
         void each_config(const std::string &wanted_key, const std::function<void (const std::string &)> &cb) const;
+        //The extra overrides are applied on top of those of the recipe
         template <typename CommandType>
-        std::shared_ptr<CommandType> create_command(Element::Type type, Language language, TargetType target_type, model::Recipe * recipe) const
+        std::shared_ptr<CommandType> create_command(Element::Type type, Language language, TargetType target_type, model::Recipe * recipe, const Overrides & extra_overrides = Overrides()) const
         {
-            Element::Ptr e = clone_(type, language, target_type);
+            Element::Ptr e = recipe_element_(type, language, target_type, recipe, extra_overrides);
 
             if (configure_command_)
                 configure_command_(e, recipe);
@@ -62,6 +67,17 @@ namespace cook { namespace process { namespace toolchain {
         std::list<std::string> config_values(const std::string & key) const { return board_.config_values(key); }
         std::list<std::pair<std::string, std::string>> all_config_values() const;
 
+        static Overrides overrides(const model::Recipe & recipe);
+        //The values of key as resolved for the commands of recipe, including its overrides
+        std::list<std::string> config_values(const std::string & key, const model::Recipe & recipe) const;
+
+        //Selects a named build configuration: its options are fixed on top of the global configuration, for all commands
+        Result set_configuration(const Overrides & configuration);
+        const Overrides & configuration() const { return configuration_; }
+
+        //The capabilities of a compiler, probed on demand and cached in cache_dir
+        Probe & probe(const std::string & compiler, const std::filesystem::path & cache_dir);
+
         const NameFunctor & primary_target_functor() const;
         void set_primary_target_functor(const NameFunctor & functor);
         void set_intermediary_name_functor(const IntermediaryName & functor);
@@ -96,6 +112,18 @@ namespace cook { namespace process { namespace toolchain {
             bool operator<(const Key & rhs) const;
         };
         Result resolve_();
+        using Elements = std::map<Key, Element::Ptr>;
+        Element::Ptr recipe_element_(Element::Type element_type, Language language, TargetType target_type, const model::Recipe * recipe, const Overrides & extra_overrides) const;
+        //The configuration and elements for a distinct set of overrides
+        struct Resolution
+        {
+            ConfigurationBoard board;
+            Elements elements;
+        };
+        Resolution resolve_overrides_(const Overrides & overrides) const;
+        //Resolves the overrides when they are not cached yet, override_elements_mutex_ has to be locked
+        const Resolution & resolution_(const Overrides & overrides) const;
+        void clear_override_elements_();
 
         bool configure_(Element & element);
         bool initialized_ = false;
@@ -106,6 +134,14 @@ namespace cook { namespace process { namespace toolchain {
         NameFunctor primary_target_functor_;
         IntermediaryName intermediary_name_;
         CommandConfigurationFunctor configure_command_;
+        std::map<std::string, std::shared_ptr<Probe>> probes_;
+
+        //The configuration and the elements before resolution, the overrides of a recipe are resolved starting from them
+        std::shared_ptr<ConfigurationBoard> pristine_board_;
+        Elements pristine_elements_;
+        mutable std::map<Overrides, Resolution> override_elements_;
+        mutable std::mutex override_elements_mutex_;
+        Overrides configuration_;
     };
 
 } } } 
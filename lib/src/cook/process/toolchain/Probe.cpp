@@ -0,0 +1,227 @@
+#include "cook/process/toolchain/Probe.hpp"
+#include "cook/util/File.hpp"
+#include "cook/OS.hpp"
+#include "gubg/hash/MD5.hpp"
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace cook { namespace process { namespace toolchain {
+
+    namespace {
+
+        const char * header = "cook probe v1";
+
+        std::string file_key(const std::filesystem::path & fn)
+        {
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(fn, ec);
+            if (ec)
+                return std::string();
+            const auto time = std::filesystem::last_write_time(fn, ec);
+            if (ec)
+                return std::string();
+
+            std::ostringstream oss;
+            oss << fn.string() << ' ' << size << ' ' << static_cast<std::int64_t>(time.time_since_epoch().count());
+            return oss.str();
+        }
+
+        std::string quote(const std::filesystem::path & fn)
+        {
+            return "\"" + fn.string() + "\"";
+        }
+
+        std::string trim(const std::string & str)
+        {
+            const auto b = str.find_first_not_of(" \t\r\n");
+            if (b == std::string::npos)
+                return std::string();
+            const auto e = str.find_last_not_of(" \t\r\n");
+            return str.substr(b, e-b+1);
+        }
+    }
+
+    Probe::Probe(const std::string & compiler, const std::filesystem::path & cache_dir)
+        : compiler_(find_executable(compiler))
+        , cache_dir_(cache_dir)
+    {
+        {
+            gubg::hash::md5::Stream s;
+            s << compiler_.string();
+            stem_ = cache_dir_ / ("probe." + s.hash_hex());
+        }
+        cache_fn_ = stem_.string() + ".txt";
+
+        const std::filesystem::path output_fn = stem_.string() + ".out";
+        runner_ = [=](const std::string & command, std::string & output)
+        {
+            const int retval = std::system((command + " > " + quote(output_fn) + " 2>&1").c_str());
+
+            std::ifstream fi(output_fn, std::ios::binary);
+            std::ostringstream oss;
+            oss << fi.rdbuf();
+            output = oss.str();
+            return retval == 0;
+        };
+
+        if (compiler_.empty())
+            return;
+
+        key_ = file_key(compiler_);
+        if (!read_cache_())
+            answers_.clear();
+    }
+
+    std::string Probe::version()
+    {
+        return answer_("version", [&](std::string & answer)
+        {
+            bool ok;
+            const std::string output = run_("--version", ok);
+            answer = ok ? trim(output.substr(0, output.find('\n'))) : std::string();
+            return ok;
+        });
+    }
+
+    std::string Probe::target()
+    {
+        return answer_("target", [&](std::string & answer)
+        {
+            bool ok;
+            const std::string output = run_("-dumpmachine", ok);
+            answer = ok ? trim(output) : std::string();
+            return ok;
+        });
+    }
+
+    bool Probe::has_flag(const std::string & flag)
+    {
+        return answer_("flag " + flag, [&](std::string & answer)
+        {
+            bool ok;
+            answer = try_build_(ok, "-Werror " + flag) ? "1" : "0";
+            return ok;
+        }) == "1";
+    }
+
+    bool Probe::has_linker(const std::string & linker)
+    {
+        return answer_("linker " + linker, [&](std::string & answer)
+        {
+            bool ok;
+            answer = try_build_(ok, "-fuse-ld=" + linker) ? "1" : "0";
+            return ok;
+        }) == "1";
+    }
+
+    std::filesystem::path Probe::find_executable(const std::string & name)
+    {
+        std::error_code ec;
+        const std::filesystem::path path(name);
+        if (path.has_parent_path())
+            return std::filesystem::is_regular_file(path, ec) ? path : std::filesystem::path();
+
+        const char * env = std::getenv("PATH");
+        if (!env)
+            return std::filesystem::path();
+
+        const char separator = (get_os() == OS::Windows ? ';' : ':');
+        std::istringstream iss(env);
+        std::string dir;
+        while (std::getline(iss, dir, separator))
+        {
+            if (dir.empty())
+                continue;
+            for (const auto & ext: {"", ".exe"})
+            {
+                const std::filesystem::path fn = std::filesystem::path(dir) / (name + ext);
+                if (std::filesystem::is_regular_file(fn, ec))
+                    return fn;
+            }
+        }
+        return std::filesystem::path();
+    }
+
+    std::string Probe::answer_(const std::string & question, const std::function<bool (std::string &)> & ask)
+    {
+        if (compiler_.empty())
+            return std::string();
+
+        auto it = answers_.find(question);
+        if (it != answers_.end())
+            return it->second;
+
+        std::string answer;
+        if (!ask(answer))
+            return answer;
+
+        answers_[question] = answer;
+        write_cache_();
+        return answer;
+    }
+
+    bool Probe::try_build_(bool & ok, const std::string & flags)
+    {
+        //Without the source, the compiler cannot tell anything about the flags
+        std::error_code ec;
+        std::filesystem::create_directories(cache_dir_, ec);
+        const std::filesystem::path source_fn = stem_.string() + ".c";
+        ok = !!util::write_if_changed(source_fn, "int main(void) { return 0; }\n");
+        if (!ok)
+            return false;
+
+        bool built;
+        run_(flags + " " + quote(source_fn) + " -o " + quote(stem_.string() + ".exe"), built);
+        return built;
+    }
+
+    std::string Probe::run_(const std::string & arguments, bool & ok)
+    {
+        ++nr_runs_;
+        std::error_code ec;
+        std::filesystem::create_directories(cache_dir_, ec);
+
+        std::string output;
+        ok = runner_(quote(compiler_) + " " + arguments, output);
+        return output;
+    }
+
+    bool Probe::read_cache_()
+    {
+        MSS_BEGIN(bool);
+
+        std::ifstream fi(cache_fn_, std::ios::binary);
+        MSS_Q(fi.good());
+
+        std::string line;
+        MSS_Q(!!std::getline(fi, line) && line == header);
+        MSS_Q(!!std::getline(fi, line) && line == "key\t" + key_);
+
+        while (std::getline(fi, line))
+        {
+            const auto ix = line.find('\t');
+            MSS(ix != std::string::npos);
+            answers_[line.substr(0, ix)] = line.substr(ix+1);
+        }
+
+        MSS_END();
+    }
+
+    Result Probe::write_cache_() const
+    {
+        MSS_BEGIN(Result);
+
+        std::ostringstream oss;
+        oss << header << std::endl;
+        oss << "key\t" << key_ << std::endl;
+        for (const auto & p: answers_)
+            oss << p.first << '\t' << p.second << std::endl;
+
+        MSS(util::write_if_changed(cache_fn_, oss.str()));
+
+        MSS_END();
+    }
+
+} } }
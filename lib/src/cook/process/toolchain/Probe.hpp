@@ -0,0 +1,67 @@
+#ifndef HEADER_cook_process_toolchain_Probe_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_toolchain_Probe_hpp_ALREADY_INCLUDED
+
+#include "cook/Result.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <functional>
+#include <map>
+#include <string>
+
+namespace cook { namespace process { namespace toolchain {
+
+    //What a gcc-like compiler supports, detected by running it. Each question is answered once: the
+    //answers are cached in the temporary directory, keyed on the path, size and modification time
+    //of the compiler binary, so warm runs do not start the compiler at all. When the probe itself
+    //fails, e.g. because its files cannot be written, the answer is not cached and asked again later.
+    class Probe
+    {
+    public:
+        //Runs a shell command, returning whether it succeeded together with its output
+        using Runner = std::function<bool (const std::string & command, std::string & output)>;
+
+        Probe(const std::string & compiler, const std::filesystem::path & cache_dir);
+
+        void set_runner(const Runner & runner) { runner_ = runner; }
+
+        //The compiler binary, as found in PATH, empty when it could not be found
+        const std::filesystem::path & compiler() const { return compiler_; }
+
+        //The first line of "--version"
+        std::string version();
+        //The target triple, as reported by "-dumpmachine"
+        std::string target();
+        //Whether a trivial program compiles and links with this flag
+        bool has_flag(const std::string & flag);
+        //Whether "-fuse-ld=<linker>" works
+        bool has_linker(const std::string & linker);
+
+        //The number of times the compiler was run
+        unsigned int nr_runs() const { return nr_runs_; }
+
+        static std::filesystem::path find_executable(const std::string & name);
+
+    private:
+        using Answers = std::map<std::string, std::string>;
+
+        //The functor returns whether the question could be asked, only those answers are cached
+        std::string answer_(const std::string & question, const std::function<bool (std::string &)> & ask);
+        bool try_build_(bool & ok, const std::string & flags);
+        std::string run_(const std::string & arguments, bool & ok);
+
+        bool read_cache_();
+        Result write_cache_() const;
+
+        std::filesystem::path compiler_;
+        std::filesystem::path cache_dir_;
+        //The files of a probe are named per compiler, different compilers can share the cache directory
+        std::filesystem::path stem_;
+        std::filesystem::path cache_fn_;
+        std::string key_;
+        Answers answers_;
+        Runner runner_;
+        unsigned int nr_runs_ = 0;
+    };
+
+} } }
+
+#endif
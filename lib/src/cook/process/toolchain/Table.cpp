@@ -0,0 +1,90 @@
+#include "cook/process/toolchain/Table.hpp"
+
+namespace cook { namespace process { namespace toolchain {
+
+    void Table::add(const std::string & key, const Rule & rule)
+    {
+        rules_[key].push_back(rule);
+    }
+
+    void Table::add(const std::string & key, const std::set<Element::Type> & element_types, const std::string & value, const Action & action)
+    {
+        Rule rule;
+        rule.element_types = element_types;
+        rule.value = value;
+        rule.action = action;
+        add(key, rule);
+    }
+
+    bool Table::process(Element & element, const std::string & key, const std::string & value, ConfigurationBoard & board) const
+    {
+        auto it = rules_.find(key);
+        if (it == rules_.end())
+            return false;
+
+        for (const auto & rule: it->second)
+        {
+            if (!rule.element_types.count(element.element_type()))
+                continue;
+            if (!rule.value.empty() && rule.value != value)
+                continue;
+            if (!rule.languages.empty() && !rule.languages.count(element.language()))
+                continue;
+
+            if (rule.action)
+                rule.action(element, value, board);
+            return true;
+        }
+
+        return false;
+    }
+
+    std::size_t Table::size() const
+    {
+        std::size_t size = 0;
+        for (const auto & p: rules_)
+            size += p.second.size();
+        return size;
+    }
+
+    Configuration Table::configuration(Configuration::priority_type priority, const std::string & uuid, const std::shared_ptr<const Table> & table)
+    {
+        Configuration cfg(priority, uuid);
+        cfg.callback = [=](Element::Ptr element, const std::string & key, const std::string & value, ConfigurationBoard & board)
+        {
+            return table->process(*element, key, value, board);
+        };
+        return cfg;
+    }
+
+    Table::Action append(Part part, const std::string & key, const std::string & value)
+    {
+        return [=](Element & element, const std::string &, ConfigurationBoard &)
+        {
+            element.key_values_map()[part].emplace_back(key, value);
+        };
+    }
+
+    Table::Action add_config(const std::string & key, const std::string & value)
+    {
+        return [=](Element &, const std::string &, ConfigurationBoard & board)
+        {
+            board.add_configuration(key, value);
+        };
+    }
+
+    Table::Action nothing()
+    {
+        return Table::Action();
+    }
+
+    Table::Action all(const std::list<Table::Action> & actions)
+    {
+        return [=](Element & element, const std::string & value, ConfigurationBoard & board)
+        {
+            for (const auto & action: actions)
+                action(element, value, board);
+        };
+    }
+
+} } }
@@ -0,0 +1,56 @@
+#ifndef HEADER_cook_process_toolchain_Table_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_toolchain_Table_hpp_ALREADY_INCLUDED
+
+#include "cook/process/toolchain/Configuration.hpp"
+#include "cook/process/toolchain/Element.hpp"
+#include "cook/Language.hpp"
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace cook { namespace process { namespace toolchain {
+
+    //Native form of a configuration callback: the rules are looked up on the configuration key
+    //instead of running through an if/else chain in chaiscript for every element and key
+    class Table
+    {
+    public:
+        using Action = std::function<void (Element & element, const std::string & value, ConfigurationBoard & board)>;
+
+        //Matches an element of one of the types, with one of the languages (any when empty) and a
+        //configuration with the given value (any when empty)
+        struct Rule
+        {
+            std::set<Element::Type> element_types;
+            std::string value;
+            std::set<Language> languages;
+            Action action;
+        };
+
+        void add(const std::string & key, const Rule & rule);
+        void add(const std::string & key, const std::set<Element::Type> & element_types, const std::string & value, const Action & action);
+
+        //Applies the first rule that matches, as the chaiscript callbacks do
+        bool process(Element & element, const std::string & key, const std::string & value, ConfigurationBoard & board) const;
+
+        std::size_t size() const;
+
+        //Wraps the table as a configuration callback, the table is shared by its copies
+        static Configuration configuration(Configuration::priority_type priority, const std::string & uuid, const std::shared_ptr<const Table> & table);
+
+    private:
+        std::map<std::string, std::list<Rule>> rules_;
+    };
+
+    //Actions that are common to most toolchains
+    Table::Action append(Part part, const std::string & key, const std::string & value = std::string());
+    Table::Action add_config(const std::string & key, const std::string & value = "true");
+    Table::Action nothing();
+    Table::Action all(const std::list<Table::Action> & actions);
+
+} } }
+
+#endif
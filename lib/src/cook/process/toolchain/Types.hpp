@@ -14,7 +14,7 @@ namespace cook { namespace process { namespace toolchain {
     enum class Part
     {
         Begin_,
-        Cli = Begin_, Pre, Runtime, Deps, Export, Response, Output, Input, DepFile, Option, Define, IncludePath, ForceInclude, Library, LibraryPath, Framework, FrameworkPath, Resource,
+        Cli = Begin_, Pre, Runtime, Deps, Export, Response, Output, Input, DepFile, Option, Define, HeaderMap, IncludePath, ForceInclude, ModuleMap, Library, LibraryPath, Framework, FrameworkPath, Resource,
         End_
     };
 
@@ -34,8 +34,10 @@ namespace cook { namespace process { namespace toolchain {
             L_CASE(DepFile);
             L_CASE(Option);
             L_CASE(Define);
+            L_CASE(HeaderMap);
             L_CASE(IncludePath);
             L_CASE(ForceInclude);
+            L_CASE(ModuleMap);
             L_CASE(Library);
             L_CASE(LibraryPath);
             L_CASE(Framework);
@@ -0,0 +1,269 @@
+#include "cook/process/toolchain/native/GCC.hpp"
+#include "cook/process/toolchain/Table.hpp"
+#include <cstdlib>
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    namespace {
+
+        //Replaces the command line interface, the executable is derived from the configuration value
+        Table::Action set_cli(const std::function<std::string (const std::string &)> & executable)
+        {
+            return [=](Element & element, const std::string & value, ConfigurationBoard &)
+            {
+                auto & cli = element.key_values_map()[Part::Cli];
+                cli.clear();
+                cli.emplace_back(executable(value), "");
+            };
+        }
+
+        Table::Action set_ctng_cli(const std::string & tool)
+        {
+            return set_cli([=](const std::string & tuple)
+            {
+                const char * home = std::getenv("HOME");
+                return std::string(home ? home : "") + "/x-tools/" + tuple + "/bin/" + tuple + "-" + tool;
+            });
+        }
+
+        Table::Action append_value(Part part, const std::string & key, const std::string & prefix = std::string())
+        {
+            return [=](Element & element, const std::string & value, ConfigurationBoard &)
+            {
+                element.key_values_map()[part].emplace_back(key, prefix + value);
+            };
+        }
+
+        Table::Rule rule(const std::set<Element::Type> & element_types, const std::string & value, const std::set<Language> & languages, const Table::Action & action)
+        {
+            Table::Rule rule;
+            rule.element_types = element_types;
+            rule.value = value;
+            rule.languages = languages;
+            rule.action = action;
+            return rule;
+        }
+
+        const auto identity = [](const std::string & value) { return value; };
+
+        //Profile-guided optimization: the directory with the profiles is set by cook, in the temporary directory
+        std::string pgo_dir(const ConfigurationBoard & board)
+        {
+            const auto dirs = board.config_values("pgo.dir");
+            return dirs.empty() ? std::string("pgo") : dirs.front();
+        }
+
+        Table::Action append_pgo(const std::string & flag, const std::string & suffix = std::string())
+        {
+            return [=](Element & element, const std::string &, ConfigurationBoard & board)
+            {
+                element.key_values_map()[Part::Pre].emplace_back(flag + pgo_dir(board) + suffix, "");
+            };
+        }
+
+        //The profile a compile command depends on, "{object}" stands for the object without its extension
+        Table::Action add_pgo_profile(const std::string & profile)
+        {
+            return [=](Element &, const std::string &, ConfigurationBoard & board)
+            {
+                board.add_configuration("pgo.profile", pgo_dir(board) + "/" + profile);
+            };
+        }
+
+        //Link-time optimization: the ThinLTO cache and the number of backend jobs are set by cook
+        std::string lto_value(const ConfigurationBoard & board, const std::string & key, const std::string & fallback)
+        {
+            const auto values = board.config_values(key);
+            return values.empty() ? fallback : values.front();
+        }
+
+        //The archiver has to understand the LTO objects, an explicitly configured archiver is kept
+        Table::Action lto_archiver(const std::string & tool)
+        {
+            return [=](Element & element, const std::string & value, ConfigurationBoard & board)
+            {
+                if (board.has_config("archiver"))
+                    return;
+                const auto tuples = board.config_values("ctng.tuple");
+                if (!tuples.empty())
+                    set_ctng_cli(tool)(element, tuples.front(), board);
+                else
+                    set_cli([=](const std::string &) { return tool; })(element, value, board);
+            };
+        }
+
+        //Adds a modifier to the operation of ar ("crs")
+        Table::Action add_ar_modifier(char modifier)
+        {
+            return [=](Element & element, const std::string &, ConfigurationBoard &)
+            {
+                for (auto & kv: element.key_values_map()[Part::Pre])
+                    if (kv.first.compare(0, 3, "crs") == 0 && kv.first.find(modifier) == std::string::npos)
+                        kv.first += modifier;
+            };
+        }
+    }
+
+    void gcc_config(Manager & manager, serialize::GCCVariant gcc_variant)
+    {
+        const bool genuine = (gcc_variant == serialize::GCCVariant::Genuine);
+        auto table = std::make_shared<Table>();
+
+        {
+            const std::set<Element::Type> compile = {Element::Compile, Element::Scan};
+            //The clang scanner is a separate tool that gets the compiler after its "--" argument
+            const std::set<Element::Type> compile_only = (genuine ? compile : std::set<Element::Type>{Element::Compile});
+
+            table->add("ctng.tuple", compile_only, "", set_ctng_cli("gcc"));
+            table->add("compiler", compile_only, "", set_cli(identity));
+            table->add("debug_symbols", compile, "true", append(Part::Pre, "-g"));
+            table->add("optimization", compile, "max_speed", append(Part::Pre, "-O3"));
+            table->add("optimization", compile, "max_size", append(Part::Pre, "-Os"));
+            //The instruction set the code is generated for, e.g. x86-64-v3
+            table->add("march", compile, "", append_value(Part::Pre, "-march"));
+            table->add("config", compile, "rtc", all({append(Part::Pre, "-fsanitize", "address"), append(Part::Pre, "-fsanitize", "undefined"), append(Part::Pre, "-fno-omit-frame-pointer")}));
+            table->add("config", compile, "profile", append(Part::Pre, "-pg"));
+            table->add("arch", compile, "x86", append(Part::Pre, "-m32"));
+            table->add("arch", compile, "x64", append(Part::Pre, "-m64"));
+            table->add("arch", compile, "armv7", all({append(Part::Pre, "-arch armv7"), add_config("position_independent_code")}));
+            table->add("arch", compile, "arm64", all({append(Part::Pre, "-arch arm64"), add_config("position_independent_code")}));
+            table->add("arch", compile, "a53", all({append(Part::Pre, "-mcpu", "cortex-a53"), append(Part::Pre, "-mfpu", "auto"), append(Part::Pre, "-funsafe-math-optimizations"), append(Part::Pre, "-ftree-vectorize")}));
+            table->add("position_independent_code", compile, "true", append(Part::Pre, "-fPIC"));
+            if (genuine)
+            {
+                table->add("c++.runtime", compile, "static", append(Part::Runtime, "-static-libstdc++"));
+                table->add("c++.runtime", compile, "", nothing());
+            }
+            table->add("c++.std", rule(compile, "", {Language::CXX, Language::ObjectiveCXX}, append_value(Part::Pre, "-std", "c++")));
+            table->add("c.std", rule(compile, "", {Language::C, Language::ObjectiveC}, append_value(Part::Pre, "-std", "c")));
+            table->add("sysroot", compile, "", append_value(Part::Pre, "--sysroot"));
+            if (genuine)
+            {
+                table->add("c++.modules", rule(compile, "true", {Language::CXX}, all({append(Part::Pre, "-fmodules-ts"), add_config("c++.modules.format", "gcc")})));
+                table->add("c++.modules", compile, "true", nothing());
+            }
+            else
+            {
+                table->add("c++.modules", rule(compile, "true", {Language::CXX}, add_config("c++.modules.format", "clang")));
+                table->add("c++.modules", compile, "true", nothing());
+                table->add("header_map", compile, "", nothing());
+            }
+            table->add("c++.modules.format", compile, "", nothing());
+            const std::set<Language> c_family = {Language::C, Language::CXX, Language::ObjectiveC, Language::ObjectiveCXX};
+            if (genuine)
+            {
+                table->add("pgo", rule({Element::Compile}, "generate", c_family, all({append_pgo("-fprofile-generate="), append(Part::Pre, "-fprofile-update=atomic")})));
+                //The profile of each object ends up in the profile directory, under the absolute path of the object
+                table->add("pgo", rule({Element::Compile}, "use", c_family, all({append_pgo("-fprofile-use="), append(Part::Pre, "-fprofile-partial-training"), append(Part::Pre, "-Wno-missing-profile"), add_pgo_profile("{object}.gcda")})));
+            }
+            else
+            {
+                table->add("pgo", rule({Element::Compile}, "generate", c_family, append_pgo("-fprofile-generate=")));
+                //The raw profiles have to be merged into default.profdata by the training script, using llvm-profdata
+                table->add("pgo", rule({Element::Compile}, "use", c_family, all({append_pgo("-fprofile-use=", "/default.profdata"), add_pgo_profile("default.profdata")})));
+            }
+            if (genuine)
+            {
+                //gcc has no ThinLTO, both modes stream the intermediate language into the objects and partition the link
+                table->add("lto", rule({Element::Compile}, "full", c_family, append(Part::Pre, "-flto")));
+                table->add("lto", rule({Element::Compile}, "thin", c_family, append(Part::Pre, "-flto")));
+            }
+            else
+            {
+                table->add("lto", rule({Element::Compile}, "full", c_family, append(Part::Pre, "-flto")));
+                table->add("lto", rule({Element::Compile}, "thin", c_family, append(Part::Pre, "-flto=thin")));
+            }
+            table->add("lto", compile, "", nothing());
+            //The linker can only reorder functions that have their own section
+            table->add("post_link", rule({Element::Compile}, "symbol_order", c_family, append(Part::Pre, "-ffunction-sections")));
+            table->add("post_link", compile, "", nothing());
+            //The debug information goes into a .dwo file next to the object, the linker does not have to process it
+            table->add("split_dwarf", rule({Element::Compile}, "true", c_family, append(Part::Pre, "-gsplit-dwarf")));
+        }
+
+        {
+            const std::set<Element::Type> link = {Element::Link};
+
+            table->add("ctng.tuple", link, "", set_ctng_cli("g++"));
+            table->add("linker", link, "", set_cli(identity));
+            table->add("arch", link, "x86", append(Part::Pre, "-m32"));
+            table->add("arch", link, "x64", append(Part::Pre, "-m64"));
+            table->add("arch", link, "armv7", append(Part::Pre, "-arch armv7"));
+            table->add("arch", link, "arm64", append(Part::Pre, "-arch arm64"));
+            table->add("config", link, "rtc", all({append(Part::Pre, "-fsanitize", "address"), append(Part::Pre, "-fsanitize", "undefined")}));
+            table->add("config", link, "profile", append(Part::Pre, "-pg"));
+            if (genuine)
+            {
+                table->add("c++.runtime", link, "static", append(Part::Runtime, "-static-libstdc++"));
+                table->add("c++.runtime", link, "", nothing());
+            }
+            table->add("c++.std", link, "", append_value(Part::Pre, "-std", "c++"));
+            table->add("c.std", link, "", append_value(Part::Pre, "-std", "c"));
+            table->add("sysroot", link, "", append_value(Part::Pre, "--sysroot"));
+            //GNU ld does not know --gdb-index, it is only added for fast linking when another linker is selected
+            table->add("fuse_ld", link, "", [](Element & element, const std::string & value, ConfigurationBoard & board)
+            {
+                auto & pre = element.key_values_map()[Part::Pre];
+                pre.emplace_back("-fuse-ld=" + value, "");
+                if (board.has_config("fast_link", "true"))
+                    pre.emplace_back("-Wl,--gdb-index", "");
+            });
+            table->add("gdb_index", link, "true", append(Part::Pre, "-Wl,--gdb-index"));
+            if (genuine)
+            {
+                //The link runs the code generation for the partitions in parallel
+                table->add("lto", link, "", [](Element & element, const std::string &, ConfigurationBoard & board)
+                {
+                    element.key_values_map()[Part::Pre].emplace_back("-flto=" + lto_value(board, "lto.jobs", "auto"), "");
+                });
+            }
+            else
+            {
+                table->add("lto", link, "full", append(Part::Pre, "-flto"));
+                //The ThinLTO backends run in parallel and reuse their results from the cache when the module did not change
+                table->add("lto", link, "thin", [](Element & element, const std::string &, ConfigurationBoard & board)
+                {
+                    auto & pre = element.key_values_map()[Part::Pre];
+                    pre.emplace_back("-flto=thin", "");
+                    pre.emplace_back("-Wl,--thinlto-cache-dir=" + lto_value(board, "lto.dir", "lto"), "");
+                    if (board.has_config("lto.jobs"))
+                        pre.emplace_back("-Wl,--thinlto-jobs=" + lto_value(board, "lto.jobs", ""), "");
+                    //The cache options are understood by lld, GNU ld would need the LLVM gold plugin
+                    if (!board.has_config("fuse_ld"))
+                        board.add_configuration("fuse_ld", "lld");
+                });
+            }
+            //BOLT rewrites the executable more thoroughly when the relocations are kept
+            table->add("post_link", link, "bolt", append(Part::Pre, "-Wl,--emit-relocs"));
+            //GNU ld does not support a symbol ordering file, lld does
+            table->add("post_link", link, "symbol_order", [](Element &, const std::string &, ConfigurationBoard & board)
+            {
+                board.add_configuration("post_link.order_option", "-Wl,--symbol-ordering-file=");
+                if (!board.has_config("fuse_ld"))
+                    board.add_configuration("fuse_ld", "lld");
+            });
+            table->add("pgo", link, "generate", append_pgo("-fprofile-generate="));
+            table->add("pgo", link, "use", nothing());
+        }
+
+        {
+            const std::set<Element::Type> archive = {Element::Archive};
+
+            table->add("ctng.tuple", archive, "", set_ctng_cli("ar"));
+            table->add("archiver", archive, "", set_cli(identity));
+            //A thin archive only references the objects, they are not copied
+            table->add("thin_archive", archive, "true", add_ar_modifier('T'));
+            //The archive is not removed before it is built, only the members that are newer than in the archive are replaced.
+            //The real timestamps are needed for this, deterministic archives store them as zero.
+            table->add("archive.update", archive, "incremental", all({add_ar_modifier('u'), add_ar_modifier('U')}));
+            table->add("archive.update", archive, "recreate", nothing());
+            //Plain ar cannot create the symbol index for objects that contain intermediate language
+            table->add("lto", archive, "", lto_archiver(genuine ? "gcc-ar" : "llvm-ar"));
+        }
+
+        table->add("fast_link", {Element::Archive, Element::Compile, Element::Link, Element::Scan, Element::UserDefined}, "true", all({add_config("split_dwarf"), add_config("thin_archive")}));
+
+        manager.add_configuration_callback(Table::configuration(100, "specific toolchain config", table));
+    }
+
+} } } }
@@ -0,0 +1,14 @@
+#ifndef HEADER_cook_process_toolchain_native_GCC_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_toolchain_native_GCC_hpp_ALREADY_INCLUDED
+
+#include "cook/process/toolchain/Manager.hpp"
+#include "cook/process/toolchain/serialize/GCC.hpp"
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    //The configuration callback of the gcc and clang toolchains, the elements are still created by the toolchain script
+    void gcc_config(Manager & manager, serialize::GCCVariant gcc_variant);
+
+} } } }
+
+#endif
@@ -0,0 +1,66 @@
+#include "cook/process/toolchain/native/MSVC.hpp"
+#include "cook/process/toolchain/Table.hpp"
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    void msvc_config(Manager & manager)
+    {
+        auto table = std::make_shared<Table>();
+
+        {
+            const std::set<Element::Type> compile = {Element::Compile};
+
+            {
+                //The resource compiler does not produce debug symbols
+                Table::Rule rule;
+                rule.element_types = compile;
+                rule.value = "true";
+                rule.languages = {Language::C, Language::CXX, Language::ASM};
+                rule.action = [](Element & element, const std::string &, ConfigurationBoard &)
+                {
+                    element.key_values_map()[Part::Pre].emplace_back("Zi", "");
+                    element.translator_map()[Part::Runtime] = [](const std::string & k, const std::string &) { return "/" + k + "d"; };
+                };
+                table->add("debug_symbols", rule);
+            }
+            table->add("optimization", compile, "max_speed", append(Part::Pre, "O2"));
+            table->add("optimization", compile, "max_size", append(Part::Pre, "O1"));
+            table->add("arch", compile, "x86", nothing());
+            table->add("arch", compile, "x64", nothing());
+            table->add("position_independent_code", compile, "true", nothing());
+            table->add("c++.runtime", compile, "dynamic", append(Part::Runtime, "MD"));
+            table->add("c++.runtime", compile, "static", append(Part::Runtime, "MT"));
+            table->add("c++.runtime", compile, "", nothing());
+            {
+                Table::Rule rule;
+                rule.element_types = compile;
+                rule.languages = {Language::CXX};
+                rule.action = [](Element & element, const std::string & value, ConfigurationBoard &)
+                {
+                    element.key_values_map()[Part::Pre].emplace_back("std", "c++" + value);
+                };
+                table->add("c++.std", rule);
+            }
+        }
+
+        //Whole program optimization, the objects contain intermediate language that the linker and lib have to know about
+        {
+            Table::Rule rule;
+            rule.element_types = {Element::Compile};
+            rule.languages = {Language::C, Language::CXX};
+            rule.action = append(Part::Pre, "GL");
+            table->add("lto", rule);
+        }
+        table->add("lto", {Element::Compile}, "", nothing());
+        table->add("lto", {Element::Link}, "full", append(Part::Pre, "LTCG"));
+        table->add("lto", {Element::Link}, "thin", append(Part::Pre, "LTCG:INCREMENTAL"));
+        table->add("lto", {Element::Archive}, "", append(Part::Pre, "LTCG"));
+
+        table->add("debug_symbols", {Element::Link}, "true", append(Part::Pre, "DEBUG"));
+        //lib always creates the library from scratch, incremental updates are not supported
+        table->add("archive.update", {Element::Archive}, "recreate", nothing());
+
+        manager.add_configuration_callback(Table::configuration(100, "specific toolchain config", table));
+    }
+
+} } } }
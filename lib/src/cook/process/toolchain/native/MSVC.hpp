@@ -0,0 +1,13 @@
+#ifndef HEADER_cook_process_toolchain_native_MSVC_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_toolchain_native_MSVC_hpp_ALREADY_INCLUDED
+
+#include "cook/process/toolchain/Manager.hpp"
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    //The configuration callback of the msvc toolchain, the elements are still created by the toolchain script
+    void msvc_config(Manager & manager);
+
+} } } }
+
+#endif
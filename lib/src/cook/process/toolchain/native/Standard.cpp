@@ -0,0 +1,54 @@
+#include "cook/process/toolchain/native/Standard.hpp"
+#include "cook/process/toolchain/Table.hpp"
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    void standard_config(Manager & manager)
+    {
+        const std::set<Element::Type> all_types = {Element::Archive, Element::Compile, Element::Link, Element::Scan, Element::UserDefined};
+
+        {
+            auto table = std::make_shared<Table>();
+            for (const std::string arch: {"x86", "x64", "armv7", "arm64", "a53", "a5"})
+                table->add(arch, all_types, "true", add_config("arch", arch));
+            table->add("x32", all_types, "true", add_config("x86"));
+            for (const std::string config: {"debug", "release", "rtc", "profile"})
+                table->add(config, all_types, "true", add_config("config", config));
+            table->add("pic", all_types, "true", add_config("position_independent_code"));
+            table->add("md", all_types, "true", add_config("c++.runtime", "dynamic"));
+            table->add("mt", all_types, "true", add_config("c++.runtime", "static"));
+            table->add("modules", all_types, "true", add_config("c++.modules"));
+            for (const std::string linker: {"lld", "mold", "gold"})
+                table->add(linker, all_types, "true", add_config("fuse_ld", linker));
+            manager.add_configuration_callback(Table::configuration(1, "single key translations", table));
+        }
+
+        {
+            //The pool depths are used by the ninja generator
+            Configuration cfg(1, "ninja pools");
+            cfg.callback = [](Element::Ptr, const std::string & key, const std::string &, ConfigurationBoard &)
+            {
+                return key.find("ninja.pool.") == 0;
+            };
+            manager.add_configuration_callback(std::move(cfg));
+        }
+
+        {
+            auto table = std::make_shared<Table>();
+            const std::set<Element::Type> compile = {Element::Compile, Element::Scan};
+            table->add("config", compile, "debug", add_config("debug_symbols"));
+            table->add("config", compile, "release", all({add_config("optimization", "max_speed"), append(Part::Define, "NDEBUG")}));
+            //Profile-guided optimization: set by cook and by the toolchain, for the souschefs
+            table->add("pgo.dir", all_types, "", nothing());
+            table->add("pgo.profile", all_types, "", nothing());
+            //Link-time optimization: the cache directory and the number of backend jobs per link
+            table->add("lto.dir", all_types, "", nothing());
+            table->add("lto.jobs", all_types, "", nothing());
+            //Post-link optimization of executables: the recorded profile, the BOLT executable and the linker option for the function order
+            for (const std::string key: {"post_link.profile", "post_link.bolt", "post_link.order_option"})
+                table->add(key, all_types, "", nothing());
+            manager.add_configuration_callback(Table::configuration(10, "standard toolchain config", table));
+        }
+    }
+
+} } } }
@@ -0,0 +1,12 @@
+#ifndef HEADER_cook_process_toolchain_native_Standard_hpp_ALREADY_INCLUDED
+#define HEADER_cook_process_toolchain_native_Standard_hpp_ALREADY_INCLUDED
+
+#include "cook/process/toolchain/Manager.hpp"
+
+namespace cook { namespace process { namespace toolchain { namespace native {
+
+    void standard_config(Manager & manager);
+
+} } } }
+
+#endif
@@ -1,6 +1,7 @@
 #include "cook/process/toolchain/serialize/GCC.hpp"
 #include "cook/process/toolchain/serialize/Standard.hpp"
 #include <string>
+#include <algorithm>
 
 namespace cook { namespace process { namespace toolchain { namespace serialize {
 
@@ -8,125 +9,8 @@ namespace cook { namespace process { namespace toolchain { namespace serialize {
     {
         standard_config(oss);
 
-        oss << R"%(cook.toolchain.configure(100, "specific toolchain config", fun(e,k,v,b) {
-    auto & kv = e.key_values();
-    auto & tm = e.translators();
-
-    if (false) {
-    } else if (e.element_type == ElementType.Compile) {
-        if (false) {
-        } else if (k == "ctng.tuple") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, "${getenv("HOME")}/x-tools/${v}/bin/${v}-gcc")
-        } else if (k == "compiler") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, v)
-        } else if (k == "debug_symbols" && v == "true") {
-            kv.append(Part.Pre, "-g")
-        } else if (k == "optimization" && v == "max_speed") {
-            kv.append(Part.Pre, "-O3")
-        } else if (k == "config" && v == "rtc") {
-            kv.append(Part.Pre, "-fsanitize", "address")
-            kv.append(Part.Pre, "-fsanitize", "undefined")
-            kv.append(Part.Pre, "-fno-omit-frame-pointer")
-        } else if (k == "config" && v == "profile") {
-            kv.append(Part.Pre, "-pg")
-        } else if (k == "arch" && v == "x86") {
-            kv.append(Part.Pre, "-m32")
-        } else if (k == "arch" && v == "x64") {
-            kv.append(Part.Pre, "-m64")
-        } else if (k == "arch" && v == "armv7") {
-            kv.append(Part.Pre, "-arch armv7")
-            b.add_config("position_independent_code", "true")
-        } else if (k == "arch" && v == "arm64") {
-            kv.append(Part.Pre, "-arch arm64")
-            b.add_config("position_independent_code", "true")
-        } else if (k == "arch" && v == "a53") {
-            kv.append(Part.Pre, "-mcpu", "cortex-a53")
-            kv.append(Part.Pre, "-mfpu", "auto")
-            kv.append(Part.Pre, "-funsafe-math-optimizations")
-            kv.append(Part.Pre, "-ftree-vectorize")
-        } else if (k == "position_independent_code" && v == "true") {
-            kv.append(Part.Pre, "-fPIC"))%";
-        if (gcc_variant == GCCVariant::Genuine)
-        {
-        oss << R"%(
-        } else if (k == "c++.runtime") {
-            if (false) {}
-            else if (v == "dynamic") { }
-            else if (v == "static") { kv.append(Part.Runtime, "-static-libstdc++") })%";
-        }
-        oss << R"%(
-        } else if (k == "c++.std" && e.language == Language.CXX) {
-            kv.append(Part.Pre, "-std", "c++${v}")
-        } else if (k == "c.std" && e.language == Language.C) {
-            kv.append(Part.Pre, "-std", "c${v}")
-        } else if (k == "c++.std" && e.language == Language.ObjectiveCXX) {
-            kv.append(Part.Pre, "-std", "c++${v}")
-        } else if (k == "c.std" && e.language == Language.ObjectiveC) {
-            kv.append(Part.Pre, "-std", "c${v}")
-        } else if (k == "sysroot") {
-            kv.append(Part.Pre, "--sysroot", v)
-        } else {
-            return false;
-        }
-    } else if (e.element_type == ElementType.Link) {
-        if (false) {
-        } else if (k == "ctng.tuple") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, "${getenv("HOME")}/x-tools/${v}/bin/${v}-g++")
-        } else if (k == "linker") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, v)
-        } else if (k == "arch" && v == "x86") {
-            kv.append(Part.Pre, "-m32", "")
-        } else if (k == "arch" && v == "x64") {
-            kv.append(Part.Pre, "-m64")
-        } else if (k == "arch" && v == "armv7") {
-            kv.append(Part.Pre, "-arch armv7", "")
-        } else if (k == "arch" && v == "arm64") {
-            kv.append(Part.Pre, "-arch arm64", "")
-        } else if (k == "config" && v == "rtc") {
-            kv.append(Part.Pre, "-fsanitize", "address") 
-            kv.append(Part.Pre, "-fsanitize", "undefined")
-        } else if (k == "config" && v == "profile") {
-            kv.append(Part.Pre, "-pg", ""))%";
-        if (gcc_variant == GCCVariant::Genuine)
-        {
-        oss << R"%(
-        } else if (k == "c++.runtime") {
-            if (false) {}
-            else if (v == "dynamic") { }
-            else if (v == "static") { kv.append(Part.Runtime, "-static-libstdc++") })%";
-        }
-        oss << R"%(
-        } else if (k == "c++.std") {
-            kv.append(Part.Pre, "-std", "c++${v}") 
-        } else if (k == "c.std") {
-            kv.append(Part.Pre, "-std", "c${v}")
-        } else if (k == "sysroot") {
-            kv.append(Part.Pre, "--sysroot", v)
-        } else {
-            return false
-        }
-    } else if (e.element_type == ElementType.Archive) {
-        if (false) {
-        } else if (k == "ctng.tuple") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, "${getenv("HOME")}/x-tools/${v}/bin/${v}-ar")
-        } else if (k == "archiver") {
-            kv.clear(Part.Cli)
-            kv.append(Part.Cli, v)
-        } else {
-            return false
-        }
-    } else {
-        return false
-    }
-    return true
-})
-
-)%";
+        //The configuration callback is native, see toolchain/native/GCC.cpp
+        oss << "cook.toolchain.configure_native(\"" << (gcc_variant == GCCVariant::Clang ? "clang" : "gcc") << "\")" << std::endl << std::endl;
 
         for (auto language: languages)
         {
@@ -145,8 +29,15 @@ namespace cook { namespace process { namespace toolchain { namespace serialize {
     tm[Part.Define]         = fun(k,v) { if (v.empty) { return "-D${k}" } else { return "-D${k}=${v}" } }
     tm[Part.IncludePath]    = fun(k,v) { if (k.empty) { return "-I./" } else { return "-I${k}" } }
     tm[Part.ForceInclude]   = fun(k,v) { return "-include ${k}" }
-
 )%";
+            if (gcc_variant == GCCVariant::Genuine)
+                oss << "    tm[Part.ModuleMap]      = fun(k,v) { return \"-fmodule-mapper=${k}\" }" << std::endl;
+            else
+            {
+                oss << "    tm[Part.ModuleMap]      = fun(k,v) { return \"@${k}\" }" << std::endl;
+                oss << "    tm[Part.HeaderMap]      = fun(k,v) { return \"-I${k}\" }" << std::endl;
+            }
+            oss << std::endl;
             oss << "    kv.append(Part.Cli, \"" << compiler << "\")" << std::endl;
             oss << "    kv.append(Part.Pre, \"-c\")" << std::endl;
             switch (language)
@@ -161,6 +52,44 @@ namespace cook { namespace process { namespace toolchain { namespace serialize {
             oss << "}" << std::endl;
         }
 
+        //The scanner extracts the module dependencies of a C++ translation unit (P1689)
+        if (std::find(languages.begin(), languages.end(), Language::CXX) != languages.end())
+        {
+            oss << R"%(
+{
+    var scanner = cook.toolchain.element(ElementType.Scan, Language.CXX, TargetType.Object)
+    var & kv = scanner.key_values()
+    var & tm = scanner.translators()
+
+    tm[Part.Cli]            = fun(k,v) { return k }
+    tm[Part.Pre]            = fun(k,v) { if (v.empty) { return k } else { return "${k}=${v}" } }
+    tm[Part.Input]          = fun(k,v) { return k }
+    tm[Part.Define]         = fun(k,v) { if (v.empty) { return "-D${k}" } else { return "-D${k}=${v}" } }
+    tm[Part.IncludePath]    = fun(k,v) { if (k.empty) { return "-I./" } else { return "-I${k}" } }
+    tm[Part.ForceInclude]   = fun(k,v) { return "-include ${k}" }
+)%";
+            if (gcc_variant == GCCVariant::Genuine)
+            {
+                oss << R"%(    tm[Part.Output]         = fun(k,v) { return "-fdeps-format=p1689r5 -fdeps-file=${k} -fdeps-target=${v} -MT ${k} -o ${k}.i" }
+    tm[Part.DepFile]        = fun(k,v) { return "-MMD -MF ${k}" }
+)%";
+                oss << "    kv.append(Part.Cli, \"" << compiler << "\")" << std::endl;
+                oss << "    kv.append(Part.Pre, \"-E\")" << std::endl;
+            }
+            else
+            {
+                oss << R"%(    tm[Part.Output]         = fun(k,v) { return "-o ${v} > ${k}" }
+)%";
+                oss << "    kv.append(Part.Cli, \"clang-scan-deps\")" << std::endl;
+                oss << "    kv.append(Part.Pre, \"-format=p1689\")" << std::endl;
+                oss << "    kv.append(Part.Pre, \"--\")" << std::endl;
+                oss << "    kv.append(Part.Pre, \"" << linker << "\")" << std::endl;
+                oss << "    kv.append(Part.Pre, \"-c\")" << std::endl;
+            }
+            oss << "    kv.append(Part.Pre, \"-x c++\")" << std::endl;
+            oss << "}" << std::endl;
+        }
+
 oss << R"%(
 
 for(s : [TargetType.SharedLibrary, TargetType.Plugin, TargetType.Executable]){
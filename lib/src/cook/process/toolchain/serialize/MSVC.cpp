@@ -7,48 +7,8 @@ namespace cook { namespace process { namespace toolchain { namespace serialize {
     {
         standard_config(oss);
 
-        oss << R"%(cook.toolchain.configure(100, "specific toolchain config", fun(e,k,v,b) {
-    auto & kv = e.key_values();
-    auto & tm = e.translators();
-
-    if (false) {
-    } else if (e.element_type == ElementType.Compile) {
-        if (false) {
-        } else if (k == "debug_symbols" && v == "true" && e.language != Language.Resource) {
-            kv.append(Part.Pre, "Zi")
-            tm[Part.Runtime] = fun(k,v) { return "/${k}d" }
-        } else if (k == "optimization" && v == "max_speed") {
-            kv.append(Part.Pre, "O2")
-        } else if (k == "arch" && v == "x86") {
-        } else if (k == "arch" && v == "x64") {
-        } else if (k == "position_independent_code" && v == "true") {
-        } else if (k == "c++.runtime") {
-            if (false) {}
-            else if (v == "dynamic") { kv.append(Part.Runtime, "MD") }
-            else if (v == "static") { kv.append(Part.Runtime, "MT") }
-        } else if (k == "c++.std" && e.language == Language.CXX) {
-            kv.append(Part.Pre, "std", "c++${v}")
-        } else {
-            return false;
-        }
-    } else if (e.element_type == ElementType.Link) {
-        if (false) {
-        } else if (k == "debug_symbols" && v == "true") {
-            kv.append(Part.Pre, "DEBUG")
-        } else {
-            return false
-        }
-    } else if (e.element_type == ElementType.Archive) {
-        if (false) {
-        } else {
-            return false
-        }
-    } else {
-        return false
-    }
-    return true
-})
-
+        //The configuration callback is native, see toolchain/native/MSVC.cpp
+        oss << R"%(cook.toolchain.configure_native("msvc")
 
 for( lang : [Language.C, Language.CXX, Language.ASM, Language.Resource]) {
 
@@ -1,4 +1,5 @@
 #include "cook/util/File.hpp"
+#include <sstream>
 
 namespace cook { namespace util {
 
@@ -17,6 +18,33 @@ Result open_file(const std::filesystem::path & path, std::ofstream & ofs)
     MSS_END();
 }
 
+Result write_if_changed(const std::filesystem::path & path, const std::string & content)
+{
+    MSS_BEGIN(Result);
+
+    {
+        std::ifstream ifs(path.string(), std::ios::binary);
+        if (ifs.good())
+        {
+            std::ostringstream oss;
+            oss << ifs.rdbuf();
+            if (oss.str() == content)
+                MSS_RETURN_OK();
+        }
+    }
+
+    std::filesystem::path parent = path.parent_path();
+    if (!parent.empty() && !std::filesystem::is_directory(parent))
+        MSG_MSS(std::filesystem::create_directories(parent), Error, "Unable to create directory '" << parent.string() << "'");
+
+    //Binary mode: the content is written as-is, which also holds for binary files
+    std::ofstream ofs(path.string(), std::ios::binary);
+    MSG_MSS(ofs.good(), Error, "Unable to create file '" << path.string() << "'");
+    ofs << content;
+
+    MSS_END();
+}
+
 std::filesystem::path get_from_to_path(const model::Recipe & from, const model::Recipe & to)
 {
     return get_from_to_path(from.working_directory(), to.working_directory());
@@ -10,6 +10,8 @@
 namespace cook { namespace util {
 
 Result open_file(const std::filesystem::path & path, std::ofstream & ofs);
+//Only writes the file when its content differs, leaving its timestamp untouched otherwise. The content is written in binary mode.
+Result write_if_changed(const std::filesystem::path & path, const std::string & content);
 
 std::filesystem::path get_from_to_path(const model::Recipe & from, const model::Recipe & to); 
 std::filesystem::path get_from_to_path(const model::Recipe & from, const std::filesystem::path & to); 
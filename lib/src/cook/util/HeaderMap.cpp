@@ -0,0 +1,141 @@
+#include "cook/util/HeaderMap.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <vector>
+
+namespace cook { namespace util {
+
+namespace {
+
+std::string to_lower(const std::string & str)
+{
+    std::string res = str;
+    std::transform(res.begin(), res.end(), res.begin(), [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); });
+    return res;
+}
+
+//Layout as defined in clang/Lex/HeaderMapTypes.h
+struct Header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t reserved;
+    std::uint32_t strings_offset;
+    std::uint32_t num_entries;
+    std::uint32_t num_buckets;
+    std::uint32_t max_value_length;
+};
+
+struct Bucket
+{
+    std::uint32_t key;
+    std::uint32_t prefix;
+    std::uint32_t suffix;
+};
+
+const std::uint32_t magic = ('h' << 24) | ('m' << 16) | ('a' << 8) | 'p';
+
+template <typename T>
+void append_raw(std::string & str, const T & t)
+{
+    str.append(reinterpret_cast<const char *>(&t), sizeof(T));
+}
+
+}
+
+void HeaderMap::add(const std::filesystem::path & dir, const std::filesystem::path & rel)
+{
+    Entry entry;
+    entry.spelling = rel.generic_string();
+    entry.prefix = (dir / "").string();
+    entry.suffix = rel.string();
+
+    auto p = entries_.emplace(to_lower(entry.spelling), entry);
+    if (!p.second)
+    {
+        Entry & present = p.first->second;
+        if (present.prefix + present.suffix != entry.prefix + entry.suffix)
+            present.ambiguous = true;
+    }
+}
+
+std::size_t HeaderMap::size() const
+{
+    return std::count_if(entries_.begin(), entries_.end(), [](const auto & p) { return !p.second.ambiguous; });
+}
+
+bool HeaderMap::lookup(std::filesystem::path & path, const std::string & spelling) const
+{
+    auto it = entries_.find(to_lower(spelling));
+    if (it == entries_.end() || it->second.ambiguous)
+        return false;
+
+    path = it->second.prefix + it->second.suffix;
+    return true;
+}
+
+unsigned int HeaderMap::hash(const std::string & spelling)
+{
+    unsigned int res = 0;
+    for (const auto ch: spelling)
+        res += static_cast<unsigned int>(std::tolower(static_cast<unsigned char>(ch))) * 13;
+    return res;
+}
+
+std::string HeaderMap::serialize() const
+{
+    const std::uint32_t num_entries = size();
+
+    //Keep the load factor below 1/2 to limit the linear probing
+    std::uint32_t num_buckets = 8;
+    while (num_buckets < 2*num_entries)
+        num_buckets *= 2;
+
+    //Offset 0 in the string pool means "empty", so the pool starts with an empty string
+    std::string strings(1, '\0');
+    auto add_string = [&](const std::string & str)
+    {
+        const std::uint32_t offset = strings.size();
+        strings.append(str);
+        strings.push_back('\0');
+        return offset;
+    };
+
+    std::vector<Bucket> buckets(num_buckets, Bucket{0, 0, 0});
+    std::uint32_t max_value_length = 0;
+    for (const auto & p: entries_)
+    {
+        const Entry & entry = p.second;
+        if (entry.ambiguous)
+            continue;
+
+        unsigned int ix = hash(entry.spelling) & (num_buckets-1);
+        while (buckets[ix].key != 0)
+            ix = (ix+1) & (num_buckets-1);
+
+        buckets[ix].key = add_string(entry.spelling);
+        buckets[ix].prefix = add_string(entry.prefix);
+        buckets[ix].suffix = add_string(entry.suffix);
+        max_value_length = std::max<std::uint32_t>(max_value_length, entry.prefix.size() + entry.suffix.size());
+    }
+
+    Header header;
+    header.magic = magic;
+    header.version = 1;
+    header.reserved = 0;
+    header.strings_offset = sizeof(Header) + num_buckets*sizeof(Bucket);
+    header.num_entries = num_entries;
+    header.num_buckets = num_buckets;
+    header.max_value_length = max_value_length;
+
+    std::string res;
+    append_raw(res, header);
+    for (const auto & bucket: buckets)
+        append_raw(res, bucket);
+    res.append(strings);
+
+    return res;
+}
+
+} }
@@ -0,0 +1,41 @@
+#ifndef HEADER_cook_util_HeaderMap_hpp_ALREADY_INCLUDED
+#define HEADER_cook_util_HeaderMap_hpp_ALREADY_INCLUDED
+
+#include "gubg/std/filesystem.hpp"
+#include <string>
+#include <map>
+
+namespace cook { namespace util {
+
+//Clang header map (.hmap): a hash table from the include spelling to the header file, which
+//replaces the linear search through all include paths for the headers cook knows about
+class HeaderMap
+{
+public:
+    //An include spelling that maps onto different files is dropped: these are left to the include paths
+    void add(const std::filesystem::path & dir, const std::filesystem::path & rel);
+
+    std::size_t size() const;
+    bool lookup(std::filesystem::path & path, const std::string & spelling) const;
+
+    //The binary representation, in native byte order as expected by clang
+    std::string serialize() const;
+
+    static unsigned int hash(const std::string & spelling);
+
+private:
+    struct Entry
+    {
+        std::string spelling;
+        std::string prefix;
+        std::string suffix;
+        bool ambiguous = false;
+    };
+
+    //Clang looks up the spellings case-insensitive
+    std::map<std::string, Entry> entries_;
+};
+
+} }
+
+#endif
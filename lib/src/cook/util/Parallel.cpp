@@ -0,0 +1,35 @@
+#include "cook/util/Parallel.hpp"
+#include "cook/log/Node.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace cook { namespace util {
+
+    void parallel_for(std::size_t size, const std::function<void (std::size_t)> & functor)
+    {
+        if (size == 0)
+            return;
+
+        const log::Ptr top = log::Node::top_ptr();
+        const int top_importance = log::Node::top_importance();
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]()
+        {
+            log::Node::top_ptr() = top;
+            log::Node::top_importance() = top_importance;
+            for (std::size_t ix; (ix = next++) < size; )
+                functor(ix);
+        };
+
+        const std::size_t nr_threads = std::min<std::size_t>(size, std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < nr_threads; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for (auto & thread: threads)
+            thread.join();
+    }
+
+} }
@@ -0,0 +1,15 @@
+#ifndef HEADER_cook_util_Parallel_hpp_ALREADY_INCLUDED
+#define HEADER_cook_util_Parallel_hpp_ALREADY_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+namespace cook { namespace util {
+
+    //Calls functor for each index in [0, size), spread over at most one thread per core, the calling thread included.
+    //The workers log into the scope of the caller. functor should not throw, the results are typically stored per index.
+    void parallel_for(std::size_t size, const std::function<void (std::size_t)> & functor);
+
+} }
+
+#endif
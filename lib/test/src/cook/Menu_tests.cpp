@@ -206,3 +206,28 @@ TEST_CASE("Dependency resolving", "[ut][algo][dependency_resolving]")
         }*/
     }
 }
+
+TEST_CASE("Resolving the closure of the root recipes", "[ut][algo][dependency_resolving]")
+{
+    Library lib;
+
+    auto * recipe_a = goc(lib, "a");
+    auto * recipe_b = goc(lib, "b");
+    auto * recipe_c = goc(lib, "c");
+    auto * recipe_d = goc(lib, "d");
+    recipe_a->add_dependency(make_uri("b"));
+    recipe_b->add_dependency(make_uri("c"));
+    recipe_d->add_dependency(make_uri("unknown"));
+
+    bool all_resolved = false;
+    REQUIRE(lib.resolve({recipe_a}, &all_resolved));
+    REQUIRE(all_resolved);
+    REQUIRE(*recipe_a->dependencies().begin() == recipe_b);
+    REQUIRE(*recipe_b->dependencies().begin() == recipe_c);
+
+    // d is outside the closure of a
+    REQUIRE(*recipe_d->dependencies().begin() == nullptr);
+
+    REQUIRE(lib.resolve({recipe_d}, &all_resolved));
+    REQUIRE(!all_resolved);
+}
@@ -0,0 +1,141 @@
+#include "catch.hpp"
+#include "cook/chai/Manifest.hpp"
+#include <sstream>
+
+using Manifest = cook::chai::Manifest;
+using Paths = std::set<std::filesystem::path>;
+
+TEST_CASE("Manifest tests", "[ut][manifest]")
+{
+    Manifest manifest;
+    manifest.set_key("key");
+    {
+        auto & root = manifest.goc_script("/r/recipes.chai");
+        root.recipes.insert("/app");
+
+        auto & a = manifest.goc_script("/r/a/recipes.chai");
+        a.parent = "/r/recipes.chai";
+        a.recipes.insert("/a/lib");
+
+        auto & b = manifest.goc_script("/r/b/recipes.chai");
+        b.parent = "/r/recipes.chai";
+        b.recipes.insert("/b/lib");
+
+        auto & b_test = manifest.goc_script("/r/b/test.chai");
+        b_test.parent = "/r/b/recipes.chai";
+        b_test.recipes.insert("/b/test");
+
+        auto & common = manifest.goc_script("/r/common.chai");
+        common.parent = "/r/recipes.chai";
+        common.has_global_effects = true;
+    }
+    manifest.add_dependency("/app", "/a/lib");
+    manifest.add_dependency("/b/test", "/b/lib");
+
+    Paths skippable;
+
+    SECTION("the closure of a root keeps its scripts")
+    {
+        REQUIRE(manifest.skippable_scripts(skippable, {"/app"}));
+        REQUIRE(skippable == Paths{"/r/b/recipes.chai", "/r/b/test.chai"});
+    }
+    SECTION("the parents of a needed script are needed")
+    {
+        REQUIRE(manifest.skippable_scripts(skippable, {"/b/test"}));
+        REQUIRE(skippable == Paths{"/r/a/recipes.chai"});
+    }
+    SECTION("an unknown root needs a full load")
+    {
+        REQUIRE(!manifest.skippable_scripts(skippable, {"/unknown"}));
+    }
+    SECTION("the scripts included by a script")
+    {
+        REQUIRE(manifest.included_scripts("/r/b/recipes.chai") == Paths{"/r/b/test.chai"});
+        REQUIRE(manifest.included_scripts("/r/recipes.chai").size() == 4);
+        REQUIRE(manifest.included_scripts("/r/b/test.chai").empty());
+    }
+    SECTION("stream and parse")
+    {
+        std::ostringstream oss;
+        manifest.stream(oss);
+
+        Manifest other;
+        std::istringstream iss(oss.str());
+        REQUIRE(other.parse(iss));
+        REQUIRE(other.key() == "key");
+        REQUIRE(other.scripts().size() == 5);
+        REQUIRE(other.scripts().at("/r/common.chai").has_global_effects);
+        REQUIRE(other.scripts().at("/r/b/test.chai").parent == "/r/b/recipes.chai");
+
+        REQUIRE(other.skippable_scripts(skippable, {"/app"}));
+        REQUIRE(skippable == Paths{"/r/b/recipes.chai", "/r/b/test.chai"});
+    }
+    SECTION("missing scripts are not up to date")
+    {
+        REQUIRE(!manifest.is_up_to_date("key"));
+        REQUIRE(!Manifest().is_up_to_date(""));
+    }
+    SECTION("the scripts of an isolated script are merged below its parent")
+    {
+        Manifest isolated;
+        {
+            auto & c = isolated.goc_script("/r/c/recipes.chai");
+            c.recipes.insert("/c/lib");
+
+            auto & c_test = isolated.goc_script("/r/c/test.chai");
+            c_test.parent = "/r/c/recipes.chai";
+            c_test.recipes.insert("/c/test");
+        }
+        isolated.add_dependency("/c/test", "/c/lib");
+        manifest.merge(isolated, "/r/recipes.chai");
+
+        REQUIRE(manifest.scripts().size() == 7);
+        REQUIRE(manifest.scripts().at("/r/c/recipes.chai").parent == "/r/recipes.chai");
+        REQUIRE(manifest.scripts().at("/r/c/test.chai").parent == "/r/c/recipes.chai");
+
+        REQUIRE(manifest.skippable_scripts(skippable, {"/app"}));
+        REQUIRE(skippable == Paths{"/r/b/recipes.chai", "/r/b/test.chai", "/r/c/recipes.chai", "/r/c/test.chai"});
+
+        REQUIRE(manifest.skippable_scripts(skippable, {"/c/test"}));
+        REQUIRE(skippable == Paths{"/r/a/recipes.chai", "/r/b/recipes.chai", "/r/b/test.chai"});
+    }
+}
+
+TEST_CASE("Manifest writes_globals tests", "[ut][manifest]")
+{
+    std::set<std::string> globals;
+    auto writes_globals = [&](const std::string & script)
+    {
+        std::istringstream iss(script);
+        return Manifest::writes_globals(iss, globals);
+    };
+
+    SECTION("recipes only")
+    {
+        REQUIRE(!writes_globals(R"(cook.recipe("lib", fun(r){ var x = 1; r.add("src", "*.cpp"); }))"));
+        REQUIRE(globals.empty());
+    }
+    SECTION("top-level declarations")
+    {
+        REQUIRE(writes_globals("var level = 3"));
+        REQUIRE(writes_globals("def helper(r) { r.add(\"src\", \"*.cpp\") }"));
+        REQUIRE(globals == std::set<std::string>{"level", "helper"});
+    }
+    SECTION("global variables in a block")
+    {
+        REQUIRE(writes_globals("if (true) { global flag = true }"));
+        REQUIRE(globals.count("flag") > 0);
+    }
+    SECTION("reassignments of known globals")
+    {
+        globals.insert("level");
+        REQUIRE(writes_globals("cook.recipe(\"a\", fun(r){ level = 4 })"));
+        REQUIRE(writes_globals("level += 1"));
+        REQUIRE(!writes_globals("if (level == 4) { print(level) }"));
+        REQUIRE(!writes_globals("r.level = 4"));
+    }
+    SECTION("comments and strings are ignored")
+    {
+        REQUIRE(!writes_globals("// var level = 3\n/* def f() {} */\nprint(\"var x = 1\")"));
+    }
+}
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+#include "cook/generator/NinjaPools.hpp"
+#include <sstream>
+
+using NinjaPools = cook::generator::NinjaPools;
+
+TEST_CASE("Ninja pools tests", "[ut][ninja]")
+{
+    const std::uint64_t GiB = std::uint64_t(1) << 30;
+    NinjaPools pools(64*GiB);
+    std::string name;
+
+    SECTION("default depths follow the memory")
+    {
+        REQUIRE(pools.depth("link") == 16);
+        REQUIRE(pools.depth("heavy") == 32);
+        REQUIRE(NinjaPools(1*GiB).depth("link") == 1);
+    }
+    SECTION("link and archive commands have their own pool")
+    {
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Link, ""));
+        REQUIRE(name == "link");
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Archive, "heavy"));
+        REQUIRE(name == "archive");
+    }
+    SECTION("compiles only use a pool when the recipe asks for it")
+    {
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Compile, ""));
+        REQUIRE(name.empty());
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Compile, "heavy"));
+        REQUIRE(name == "heavy");
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Compile, "console"));
+        REQUIRE(name == "console");
+        REQUIRE(!pools.pool(name, cook::process::command::Interface::Compile, "unknown"));
+    }
+    SECTION("configured depths")
+    {
+        REQUIRE(pools.set_depth("link", "2"));
+        REQUIRE(pools.set_depth("codegen", "3"));
+        REQUIRE(pools.set_depth("archive", "0"));
+        REQUIRE(!pools.set_depth("link", "two"));
+        REQUIRE(!pools.set_depth("console", "2"));
+        REQUIRE(!pools.set_depth("link", "4294967296"));
+
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Compile, "codegen"));
+        REQUIRE(name == "codegen");
+        REQUIRE(pools.pool(name, cook::process::command::Interface::Archive, ""));
+        REQUIRE(name.empty());
+
+        std::ostringstream oss;
+        pools.stream(oss);
+        REQUIRE(oss.str() == "pool codegen\n   depth = 3\npool heavy\n   depth = 32\npool link\n   depth = 2\n");
+    }
+    SECTION("LTO links share the cores")
+    {
+        REQUIRE(pools.set_link_jobs("1000000"));
+        REQUIRE(pools.depth("link") == 1);
+        REQUIRE(!pools.set_link_jobs("all"));
+        REQUIRE(!pools.set_link_jobs(""));
+        //Out of range, instead of wrapping around to 0
+        REQUIRE(!pools.set_link_jobs("4294967296"));
+        REQUIRE(!pools.set_link_jobs("99999999999999999999999"));
+        REQUIRE(pools.set_link_jobs("0"));
+        REQUIRE(pools.depth("link") == 1);
+    }
+}
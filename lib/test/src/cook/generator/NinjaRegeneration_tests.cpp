@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "cook/generator/NinjaRegeneration.hpp"
+#include "cook/test/Fixture.hpp"
+#include <fstream>
+#include <sstream>
+
+using NinjaRegeneration = cook::generator::NinjaRegeneration;
+using Paths = std::set<std::filesystem::path>;
+
+TEST_CASE("Ninja regeneration tests", "[ut][ninja]")
+{
+    cook::test::TemporaryDir tmp("cook_ninja_regeneration_tests");
+    const std::filesystem::path & dir = tmp.path;
+    for (const auto & sub: {"src/sub", "build/.cook", "objs", ".cook"})
+        std::filesystem::create_directories(dir / sub);
+    std::ofstream(dir / "src" / "a.cpp") << "int a;";
+
+    SECTION("an output directory inside the sources is not walked")
+    {
+        NinjaRegeneration regeneration(dir / "build" / "build.ninja", dir / "build" / ".cook", dir / "build");
+        regeneration.add_script(dir / "recipes.chai");
+        regeneration.add_glob_root(dir);
+        REQUIRE(regeneration.inputs() == Paths{dir / "recipes.chai", dir, dir / ".cook", dir / "objs", dir / "src", dir / "src" / "sub"});
+    }
+    SECTION("the directories the build writes into are no input")
+    {
+        //The default output directory is where the sources are globbed: ninja and the build outputs write there
+        NinjaRegeneration regeneration(dir / "build.ninja", dir / ".cook", dir);
+        regeneration.add_glob_root(dir / "." / "");
+        regeneration.add_output(dir / "app");
+        regeneration.add_output(dir / "objs" / "a.o");
+        REQUIRE(regeneration.inputs() == Paths{dir / "build", dir / "build" / ".cook", dir / "src", dir / "src" / "sub"});
+    }
+    SECTION("input directories are watched, also in the temporary directory")
+    {
+        std::filesystem::create_directories(dir / ".cook" / "pgo" / "sub");
+        NinjaRegeneration regeneration(dir / "build.ninja", dir / ".cook", dir);
+        regeneration.add_glob_root(dir);
+        regeneration.add_input_dir(dir / ".cook" / "pgo");
+        const auto inputs = regeneration.inputs();
+        REQUIRE(inputs.count(dir / ".cook") == 0);
+        REQUIRE(inputs.count(dir / ".cook" / "pgo") == 1);
+        REQUIRE(inputs.count(dir / ".cook" / "pgo" / "sub") == 1);
+    }
+    SECTION("missing glob roots are skipped")
+    {
+        NinjaRegeneration regeneration(dir / "build.ninja", dir / ".cook", dir);
+        regeneration.add_glob_root(dir / "unknown");
+        REQUIRE(regeneration.inputs().empty());
+    }
+    SECTION("arguments are quoted for the shell and escaped for ninja")
+    {
+        REQUIRE(NinjaRegeneration::quote_argument("-g") == "-g");
+        REQUIRE(NinjaRegeneration::quote_argument("") == "\"\"");
+        REQUIRE(NinjaRegeneration::quote_argument("my recipes.chai") == "\"my recipes.chai\"");
+        REQUIRE(NinjaRegeneration::quote_argument("$HOME") == "$$HOME");
+        REQUIRE(NinjaRegeneration::quote_argument("a;b") == "\"a;b\"");
+        REQUIRE(NinjaRegeneration::quote_argument("say \"hi\"") == "\"say \\\"hi\\\"\"");
+    }
+    SECTION("stream")
+    {
+        NinjaRegeneration regeneration(dir / "build.ninja", dir / ".cook", dir);
+        regeneration.add_script("/my recipes/recipes.chai");
+        std::ostringstream oss;
+        regeneration.stream(oss, "/usr/bin/cook", {"-f", "my recipes"}, "/work");
+        const std::string str = oss.str();
+        REQUIRE(str.find("rule cook") != std::string::npos);
+        REQUIRE(str.find("/usr/bin/cook -f \"my recipes\"") != std::string::npos);
+        REQUIRE(str.find("generator = 1") != std::string::npos);
+        REQUIRE(str.find(": cook | /my$ recipes/recipes.chai") != std::string::npos);
+    }
+
+}
@@ -0,0 +1,42 @@
+#include "catch.hpp"
+#include "cook/log/Scope.hpp"
+#include <thread>
+
+using namespace cook;
+
+TEST_CASE("Log scope tests", "[ut][log]")
+{
+    const int level = log::level();
+    log::set_level(0);
+
+    const auto top = log::Node::top_ptr();
+
+    SECTION("filtered scopes do not format their attributes")
+    {
+        bool formatted = false;
+        {
+            auto ss = log::scope("filtered", -1, [&](auto & n) { formatted = true; n.attr("a", 1); });
+            REQUIRE(log::Node::top_ptr() == top);
+            REQUIRE(log::importance(log::Importance{}) == -1);
+
+            // the importance of a filtered scope is inherited
+            auto ss2 = log::scope("child", [&](auto & n) { formatted = true; });
+            REQUIRE(log::importance(log::Importance{}) == -1);
+        }
+        REQUIRE(!formatted);
+        REQUIRE(log::importance(log::Importance{}) == top->importance());
+    }
+    SECTION("each thread has its own scopes")
+    {
+        log::Ptr other_top;
+        {
+            auto ss = log::scope("main", -1);
+            std::thread thread([&]() { other_top = log::Node::top_ptr(); });
+            thread.join();
+        }
+        REQUIRE(other_top != top);
+        REQUIRE(log::Node::top_ptr() == top);
+    }
+
+    log::set_level(level);
+}
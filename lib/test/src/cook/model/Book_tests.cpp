@@ -0,0 +1,38 @@
+#include "catch.hpp"
+#include "cook/model/Library.hpp"
+#include "cook/model/Recipe.hpp"
+
+using namespace cook::model;
+
+TEST_CASE("Merging books of different libraries", "[ut][model][book]")
+{
+    Library lib;
+    Library other;
+
+    Recipe * a = nullptr;
+    Recipe * b = nullptr;
+    Recipe * c = nullptr;
+    REQUIRE(lib.goc_recipe(a, Uri("/x/a")));
+    REQUIRE(other.goc_recipe(b, Uri("/x/b")));
+    REQUIRE(other.goc_recipe(c, Uri("/y/c")));
+
+    SECTION("disjoint recipes are moved")
+    {
+        REQUIRE(lib.root()->merge(*other.root()));
+        REQUIRE(lib.list_all_recipes().size() == 3);
+        REQUIRE(other.list_all_recipes().empty());
+
+        Recipe * found = nullptr;
+        REQUIRE(lib.find_recipe(found, Uri("/x/b")));
+        REQUIRE(found == b);
+        REQUIRE(b->parent() == a->parent());
+        REQUIRE(lib.find_recipe(found, Uri("/y/c")));
+        REQUIRE(found == c);
+    }
+    SECTION("a recipe in both libraries is an error")
+    {
+        Recipe * a2 = nullptr;
+        REQUIRE(other.goc_recipe(a2, Uri("/x/a")));
+        REQUIRE(!lib.root()->merge(*other.root()));
+    }
+}
@@ -0,0 +1,140 @@
+#include "catch.hpp"
+#include "cook/process/analysis/BuildTime.hpp"
+#include <sstream>
+
+using namespace cook::process::analysis;
+
+namespace  {
+
+//In the order the commands finish, as ninja appends them
+const char * ninja_log = "# ninja log v5\n"
+"0\t100\t0\tobj/a.o\tabc\n"
+"100\t150\t0\tobj/c.o\tabc\n"
+"0\t300\t0\tobj/b.o\tabc\n"
+"300\t400\t0\tlib/libab.a\tabc\n"
+"400\t500\t0\t./bin/app\tabc\n";
+
+}
+
+TEST_CASE("Ninja log parsing tests", "[ut][analysis]")
+{
+    NinjaLog log;
+
+    SECTION("valid log")
+    {
+        std::istringstream iss(ninja_log);
+        REQUIRE(parse(log, iss));
+        REQUIRE(log.size() == 5);
+        REQUIRE(log["obj/b.o"].duration_ms() == 300);
+        REQUIRE(log.count("bin/app") == 1);
+    }
+    SECTION("later entries overwrite earlier ones")
+    {
+        std::istringstream iss("# ninja log v6\n0\t100\t0\ta.o\tabc\n0\t20\t0\ta.o\tdef\n");
+        REQUIRE(parse(log, iss));
+        REQUIRE(log["a.o"].duration_ms() == 20);
+    }
+    SECTION("each decreasing end time starts a new run")
+    {
+        std::istringstream iss("# ninja log v5\n0\t100\t0\ta.o\tabc\n0\t200\t0\tb.o\tabc\n0\t50\t0\ta.o\tdef\n");
+        REQUIRE(parse(log, iss));
+        REQUIRE(log["a.o"].run == 1);
+        REQUIRE(log["b.o"].run == 0);
+    }
+    SECTION("missing header")
+    {
+        std::istringstream iss("0\t100\t0\ta.o\tabc\n");
+        REQUIRE(!parse(log, iss));
+    }
+    SECTION("invalid line")
+    {
+        std::istringstream iss("# ninja log v5\n100\t0\t0\ta.o\tabc\n");
+        REQUIRE(!parse(log, iss));
+    }
+}
+
+TEST_CASE("Build time analysis tests", "[ut][analysis]")
+{
+    NinjaLog log;
+    {
+        std::istringstream iss(ninja_log);
+        REQUIRE(parse(log, iss));
+    }
+
+    BuildTime build_time;
+    const auto a = build_time.add_job("lib/ab", {"obj/a.o"});
+    const auto b = build_time.add_job("lib/ab", {"obj/b.o"});
+    const auto ab = build_time.add_job("lib/ab", {"lib/libab.a"});
+    const auto c = build_time.add_job("app", {"obj/c.o"});
+    const auto app = build_time.add_job("app", {"bin/app"});
+    build_time.add_dependency(ab, a);
+    build_time.add_dependency(ab, b);
+    build_time.add_dependency(app, ab);
+    build_time.add_dependency(app, c);
+
+    SECTION("critical path")
+    {
+        REQUIRE(build_time.analyse(log));
+        REQUIRE(build_time.critical_path() == std::list<BuildTime::JobId>{b, ab, app});
+        REQUIRE(build_time.critical_path_ms() == 500);
+    }
+    SECTION("recipe cost")
+    {
+        REQUIRE(build_time.analyse(log));
+        const auto & costs = build_time.recipe_costs();
+        REQUIRE(costs.at("lib/ab").cumulative_ms == 500);
+        REQUIRE(costs.at("lib/ab").critical_ms == 400);
+        REQUIRE(costs.at("app").cumulative_ms == 150);
+        REQUIRE(costs.at("app").critical_ms == 100);
+        REQUIRE(build_time.cumulative_ms() == 650);
+    }
+    SECTION("parallelism profile")
+    {
+        REQUIRE(build_time.analyse(log));
+        REQUIRE(build_time.wall_ms() == 500);
+        const auto & parallelism = build_time.parallelism();
+        REQUIRE(parallelism.at(1) == 350);
+        REQUIRE(parallelism.at(2) == 150);
+    }
+    SECTION("the parallelism profile only uses the last run")
+    {
+        //A later incremental build that only relinks the application, its clock starts again at 0
+        std::istringstream iss("# ninja log v5\n0\t100\t0\ta.o\tabc\n0\t300\t0\tb.o\tabc\n0\t50\t0\tbin/app\tdef\n");
+        NinjaLog incremental;
+        REQUIRE(parse(incremental, iss));
+        REQUIRE(build_time.analyse(incremental));
+        REQUIRE(build_time.wall_ms() == 50);
+        REQUIRE(build_time.parallelism() == std::map<unsigned int, unsigned long>{{1, 50}});
+    }
+    SECTION("re-analysis forgets the timings that are gone")
+    {
+        REQUIRE(build_time.analyse(log));
+        NinjaLog partial = log;
+        partial.erase("bin/app");
+        REQUIRE(build_time.analyse(partial));
+        REQUIRE(!build_time.jobs()[app].timed);
+        REQUIRE(build_time.jobs()[app].entry.duration_ms() == 0);
+        REQUIRE(build_time.cumulative_ms() == 550);
+        REQUIRE(build_time.critical_path_ms() == 400);
+    }
+    SECTION("commands without timing do not contribute")
+    {
+        const auto gen = build_time.add_job("app", {"gen/version.hpp"});
+        build_time.add_dependency(c, gen);
+        REQUIRE(build_time.analyse(log));
+        REQUIRE(build_time.recipe_costs().at("app").untimed == 1);
+        REQUIRE(build_time.critical_path_ms() == 500);
+    }
+    SECTION("cycle")
+    {
+        build_time.add_dependency(a, app);
+        REQUIRE(!build_time.analyse(log));
+    }
+    SECTION("report")
+    {
+        REQUIRE(build_time.analyse(log));
+        std::ostringstream oss;
+        build_time.stream_report(oss);
+        REQUIRE(oss.str().find("\"critical_path_ms\": 500") != std::string::npos);
+    }
+}
@@ -0,0 +1,64 @@
+#include "catch.hpp"
+#include "cook/process/command/Compile.hpp"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace cook;
+using Part = process::toolchain::Part;
+
+TEST_CASE("Compile command tests", "[ut][process][command]")
+{
+    auto element = std::make_shared<process::toolchain::Element>(process::toolchain::Element::Compile, Language::CXX, TargetType::Object);
+    auto & trans = element->translator_map();
+    unsigned int nr_define_translations = 0;
+    trans[Part::Cli] = [](const std::string & k, const std::string &) { return k; };
+    trans[Part::Define] = [&](const std::string & k, const std::string & v) { ++nr_define_translations; return "-D" + k + (v.empty() ? "" : "=" + v); };
+    trans[Part::Input] = [](const std::string & k, const std::string &) { return "-c " + k; };
+    trans[Part::Output] = [](const std::string & k, const std::string &) { return "-o " + k; };
+    trans[Part::DepFile] = [](const std::string & k, const std::string &) { return "-MF " + k; };
+    element->key_values_map()[Part::Cli].emplace_back("g++", "");
+
+    process::command::Compile cmd(element);
+    REQUIRE(!cmd.process_ingredient(LanguageTypePair(Language::Undefined, Type::Define), ingredient::KeyValue("NDEBUG")));
+
+    auto stream = [&]() { std::ostringstream oss; cmd.stream_command(oss); return oss.str(); };
+
+    SECTION("only the inputs and outputs are translated for each build statement")
+    {
+        cmd.set_inputs_outputs({"a.cpp"}, {"a.o"});
+        REQUIRE(stream() == "g++ -o a.o -c a.cpp -MF a.o.d -DNDEBUG ");
+        REQUIRE(nr_define_translations == 1);
+
+        cmd.set_inputs_outputs({"b c.cpp"}, {"b.o"});
+        REQUIRE(stream() == "g++ -o b.o -c \"b c.cpp\" -MF b.o.d -DNDEBUG ");
+        REQUIRE(nr_define_translations == 1);
+    }
+    SECTION("new ingredients are picked up")
+    {
+        REQUIRE(stream() == "g++ -DNDEBUG ");
+        REQUIRE(!cmd.process_ingredient(LanguageTypePair(Language::Undefined, Type::Define), ingredient::KeyValue("A", "1")));
+        REQUIRE(stream() == "g++ -DNDEBUG -DA=1 ");
+        REQUIRE(nr_define_translations == 3);
+    }
+    SECTION("an explicit translator bypasses the cached translation")
+    {
+        std::ostringstream oss;
+        process::toolchain::Translator identity = [](const std::string & k, const std::string &) { return k; };
+        REQUIRE(cmd.stream_part(oss, Part::Define, &identity));
+        REQUIRE(oss.str() == "NDEBUG");
+        REQUIRE(!cmd.stream_part(oss, Part::Library));
+    }
+    SECTION("concurrent readers share the cached translation")
+    {
+        std::vector<std::string> strs(4);
+        std::vector<std::thread> threads;
+        for (auto & str: strs)
+            threads.emplace_back([&]() { str = stream(); });
+        for (auto & thread: threads)
+            thread.join();
+        for (const auto & str: strs)
+            REQUIRE(str == "g++ -DNDEBUG ");
+        REQUIRE(nr_define_translations == 1);
+    }
+}
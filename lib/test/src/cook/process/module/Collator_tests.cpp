@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "cook/process/module/Collator.hpp"
+#include <sstream>
+
+using namespace cook::process::module;
+
+namespace  {
+
+const char * interface_ddi = R"%({
+  "rules": [
+    {
+      "primary-output": "math.cpp.obj",
+      "provides": [ { "logical-name": "math", "is-interface": true } ],
+      "requires": [ { "logical-name": "math:detail" } ]
+    }
+  ],
+  "version": 0,
+  "revision": 0
+})%";
+
+const char * partition_ddi = R"%({ "rules": [ { "primary-output": "detail.cpp.obj", "provides": [ { "logical-name": "math:detail" } ] } ], "version": 0, "revision": 0 })%";
+
+const char * consumer_ddi = R"%({ "rules": [ { "primary-output": "main.cpp.obj", "requires": [ { "logical-name": "math", "lookup-method": "by-name" } ] } ], "version": 0, "revision": 0 })%";
+
+}
+
+TEST_CASE("P1689 parsing tests", "[ut][module]")
+{
+    P1689 info;
+
+    SECTION("provides and requires")
+    {
+        REQUIRE(parse(info, interface_ddi));
+        REQUIRE(info.rules.size() == 1);
+        const auto & rule = info.rules.front();
+        REQUIRE(rule.primary_output == "math.cpp.obj");
+        REQUIRE(rule.provides.size() == 1);
+        REQUIRE(rule.provides.front().logical_name == "math");
+        REQUIRE(rule.required == std::list<std::string>{"math:detail"});
+    }
+    SECTION("no modules")
+    {
+        REQUIRE(parse(info, R"%({ "rules": [ { "primary-output": "a.obj" } ], "version": 0 })%"));
+        REQUIRE(info.rules.size() == 1);
+        REQUIRE(info.rules.front().provides.empty());
+        REQUIRE(info.rules.front().required.empty());
+    }
+    SECTION("invalid json")
+    {
+        REQUIRE(!parse(info, R"%({ "rules": [ )%"));
+    }
+    SECTION("no rules")
+    {
+        REQUIRE(!parse(info, R"%({ "version": 0 })%"));
+    }
+}
+
+TEST_CASE("Collator tests", "[ut][module]")
+{
+    P1689 interface, partition, consumer;
+    REQUIRE(parse(interface, interface_ddi));
+    REQUIRE(parse(partition, partition_ddi));
+    REQUIRE(parse(consumer, consumer_ddi));
+
+    Collator collator(Format::GCC, "bmi");
+    REQUIRE(collator.add_dependency(interface));
+    REQUIRE(collator.add_dependency(partition));
+    REQUIRE(collator.add_own("main.cpp.obj.ddi", consumer));
+
+    SECTION("dyndep")
+    {
+        std::ostringstream oss;
+        REQUIRE(collator.stream_dyndep(oss));
+        const auto bmi = collator.bmi("math").string();
+        REQUIRE(oss.str() == "ninja_dyndep_version = 1\nbuild main.cpp.obj: dyndep | " + bmi + "\n");
+    }
+    SECTION("gcc module map contains the transitive imports")
+    {
+        std::ostringstream oss;
+        REQUIRE(collator.stream_module_map(oss, "main.cpp.obj"));
+        REQUIRE(oss.str() == "math " + collator.bmi("math").string() + "\nmath:detail " + collator.bmi("math:detail").string() + "\n");
+    }
+    SECTION("partitions get a valid filename")
+    {
+        REQUIRE(collator.bmi("math:detail").filename().string() == "math-detail.gcm");
+    }
+    SECTION("unknown module")
+    {
+        P1689 other;
+        REQUIRE(parse(other, R"%({ "rules": [ { "primary-output": "b.obj", "requires": [ { "logical-name": "unknown" } ] } ] })%"));
+        REQUIRE(collator.add_own("b.obj.ddi", other));
+
+        std::ostringstream oss;
+        REQUIRE(!collator.stream_module_map(oss, "b.obj"));
+    }
+}
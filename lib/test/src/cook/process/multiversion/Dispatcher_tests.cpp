@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "cook/process/multiversion/Dispatcher.hpp"
+#include "cook/model/Library.hpp"
+#include <sstream>
+
+using Dispatcher = cook::process::multiversion::Dispatcher;
+using cook::LanguageTypePair;
+
+namespace  {
+
+void add(cook::model::Recipe & recipe, const std::string & key, const std::string & value, cook::model::Recipe * owner = nullptr)
+{
+    cook::ingredient::KeyValue kv(key, value);
+    kv.set_owner(owner ? owner : &recipe);
+    REQUIRE(recipe.insert(LanguageTypePair(cook::Language::Undefined, cook::Type::Undefined), kv));
+}
+
+void add_source(cook::model::Recipe & recipe, cook::Language language, const std::string & rel)
+{
+    cook::ingredient::File file("src", rel);
+    file.set_owner(&recipe);
+    REQUIRE(recipe.insert(LanguageTypePair(language, cook::Type::Source), file));
+}
+
+}
+
+TEST_CASE("Multiversion dispatcher tests", "[ut][multiversion]")
+{
+    cook::model::Library lib;
+    cook::model::Recipe * recipe = nullptr;
+    REQUIRE(lib.goc_recipe(recipe, cook::model::Uri("/kernels")));
+
+    Dispatcher dispatcher;
+
+    SECTION("recipes without instruction sets are not multiversioned")
+    {
+        REQUIRE(Dispatcher::from_recipe(dispatcher, *recipe));
+        REQUIRE(dispatcher.empty());
+    }
+    SECTION("propagated key-values do not count")
+    {
+        cook::model::Recipe * dependency = nullptr;
+        REQUIRE(lib.goc_recipe(dependency, cook::model::Uri("/dependency")));
+        add(*recipe, "multiversion.isa", "x86-64-v3", dependency);
+        REQUIRE(Dispatcher::from_recipe(dispatcher, *recipe));
+        REQUIRE(dispatcher.empty());
+    }
+    SECTION("the functions, header and sources are required")
+    {
+        add_source(*recipe, cook::Language::CXX, "dot.cpp");
+        add(*recipe, "multiversion.isa", "x86-64-v3");
+        REQUIRE(!Dispatcher::from_recipe(dispatcher, *recipe));
+        add(*recipe, "multiversion.functions", "dot");
+        REQUIRE(!Dispatcher::from_recipe(dispatcher, *recipe));
+        add(*recipe, "multiversion.header", "kernels.h");
+        REQUIRE(!Dispatcher::from_recipe(dispatcher, *recipe));
+        add(*recipe, "multiversion.sources", "dot.cpp");
+        REQUIRE(Dispatcher::from_recipe(dispatcher, *recipe));
+    }
+    SECTION("the sources are known and of one language")
+    {
+        add_source(*recipe, cook::Language::C, "dot.c");
+        add_source(*recipe, cook::Language::CXX, "axpy.cpp");
+        add(*recipe, "multiversion.isa", "x86-64-v3");
+        add(*recipe, "multiversion.functions", "dot axpy");
+        add(*recipe, "multiversion.header", "kernels.h");
+        SECTION("unknown")
+        {
+            add(*recipe, "multiversion.sources", "dot.c unknown.c");
+            REQUIRE(!Dispatcher::from_recipe(dispatcher, *recipe));
+        }
+        SECTION("mixed")
+        {
+            add(*recipe, "multiversion.sources", "dot.c axpy.cpp");
+            REQUIRE(!Dispatcher::from_recipe(dispatcher, *recipe));
+        }
+    }
+    SECTION("dispatcher")
+    {
+        add_source(*recipe, cook::Language::CXX, "kernels.cpp");
+        add_source(*recipe, cook::Language::CXX, "main.cpp");
+        add(*recipe, "multiversion.isa", "x86-64-v2 x86-64-v3");
+        add(*recipe, "multiversion.functions", "dot axpy");
+        add(*recipe, "multiversion.header", "kernels.h");
+        add(*recipe, "multiversion.sources", "kernels.cpp");
+        REQUIRE(Dispatcher::from_recipe(dispatcher, *recipe));
+        REQUIRE(dispatcher.language() == cook::Language::CXX);
+        REQUIRE(dispatcher.is_selected(cook::ingredient::File("src", "kernels.cpp")));
+        REQUIRE(!dispatcher.is_selected(cook::ingredient::File("src", "main.cpp")));
+        REQUIRE(dispatcher.isas().size() == 2);
+        REQUIRE(Dispatcher::suffix("x86-64-v3") == "x86_64_v3");
+        REQUIRE(dispatcher.variant("dot", "x86-64-v3") == "dot_x86_64_v3");
+
+        std::ostringstream oss;
+        dispatcher.stream(oss);
+        const std::string str = oss.str();
+        REQUIRE(str.find("#include \"kernels.h\"") != std::string::npos);
+        REQUIRE(str.find("__typeof__(dot) dot_default, dot_x86_64_v2, dot_x86_64_v3;") != std::string::npos);
+        //The highest instruction set is tried first
+        REQUIRE(str.find("x86-64-v3\")) return dot_x86_64_v3;") < str.find("x86-64-v2\")) return dot_x86_64_v2;"));
+        REQUIRE(str.find("__typeof__(axpy) axpy __attribute__((ifunc(\"cook_resolve_axpy\")));") != std::string::npos);
+    }
+}
@@ -0,0 +1,81 @@
+#include "catch.hpp"
+#include "cook/process/souschef/Archiver.hpp"
+#include "cook/test/Fixture.hpp"
+#include <fstream>
+#include <set>
+
+TEST_CASE("Archiver tests", "[ut][souschef][archiver]")
+{
+    using namespace cook;
+    test::TemporaryDir tmp("cook_archiver_tests");
+    const std::filesystem::path & dir = tmp.path;
+    std::filesystem::create_directories(dir / "output");
+
+    test::Context context(dir);
+    test::GCCToolchain toolchain(context.toolchain());
+    REQUIRE(toolchain.initialize({{"archive.update", "incremental"}}));
+
+    model::Library lib;
+    model::Recipe * recipe = nullptr;
+    REQUIRE(lib.goc_recipe(recipe, model::Uri("/lib")));
+
+    //The explicit inputs and outputs of the archive command of the last run
+    std::set<std::string> inputs, outputs;
+
+    //Processes the recipe with these objects, as a new run of cook would
+    auto run = [&](const std::list<std::string> & objects)
+    {
+        recipe->restore(model::Recipe::Snapshot{});
+        recipe->build_target().type = TargetType::Archive;
+        recipe->build_target().filename = "liblib.a";
+        for (const auto & object: objects)
+        {
+            ingredient::File file(dir / "objects", object);
+            file.set_owner(recipe);
+            REQUIRE(recipe->insert(LanguageTypePair(Language::Binary, Type::Object), file));
+        }
+        using Graph = process::build::Graph;
+        process::RecipeFilteredGraph g(std::make_shared<Graph>());
+        const Result rc = process::souschef::Archiver().process(*recipe, g, context);
+
+        inputs.clear();
+        outputs.clear();
+        for (auto vertex: g.command_vertices())
+        {
+            g.input([&](auto v){ inputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Explicit);
+            g.output([&](auto v){ outputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Explicit);
+        }
+        return rc;
+    };
+
+    const std::filesystem::path archive_fn = dir / "output" / "liblib.a";
+    REQUIRE(run({"a.o", "b.o"}));
+    std::ofstream(archive_fn) << "archive";
+
+    SECTION("the objects are the members of the archive")
+    {
+        REQUIRE(inputs == std::set<std::string>{(dir / "objects" / "a.o").string(), (dir / "objects" / "b.o").string()});
+        REQUIRE(outputs == std::set<std::string>{archive_fn.string()});
+    }
+    SECTION("same members keep the archive")
+    {
+        REQUIRE(run({"a.o", "b.o"}));
+        REQUIRE(std::filesystem::exists(archive_fn));
+    }
+    SECTION("new members keep the archive")
+    {
+        REQUIRE(run({"a.o", "b.o", "c.o"}));
+        REQUIRE(std::filesystem::exists(archive_fn));
+    }
+    SECTION("removed members recreate the archive")
+    {
+        REQUIRE(run({"a.o"}));
+        REQUIRE(!std::filesystem::exists(archive_fn));
+
+        //The members of this run are the reference for the next one
+        std::ofstream(archive_fn) << "archive";
+        REQUIRE(run({"a.o"}));
+        REQUIRE(std::filesystem::exists(archive_fn));
+    }
+
+}
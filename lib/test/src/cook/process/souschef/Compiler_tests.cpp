@@ -0,0 +1,246 @@
+#include "catch.hpp"
+#include "cook/process/souschef/Compiler.hpp"
+#include "cook/process/command/Scan.hpp"
+#include "cook/test/Fixture.hpp"
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace  {
+
+//The files around a compile command, as seen by a generator
+struct Step
+{
+    std::string source;
+    std::set<std::string> implicit_inputs;
+    std::set<std::string> implicit_outputs;
+};
+
+}
+
+TEST_CASE("Compiler tests", "[ut][souschef][compiler]")
+{
+    using namespace cook;
+    using Graph = process::build::Graph;
+    using GCCVariant = test::GCCToolchain::GCCVariant;
+
+    test::TemporaryDir tmp("cook_compiler_tests");
+    const std::filesystem::path & dir = tmp.path;
+    std::filesystem::create_directories(dir / "pgo");
+
+    test::Context context(dir);
+
+    struct Scn
+    {
+        GCCVariant variant = GCCVariant::Genuine;
+        test::GCCToolchain::Options config;
+        bool create_profiles = false;
+    };
+    struct Exp
+    {
+        bool dwo = false;
+    };
+
+    Scn scn;
+    Exp exp;
+
+    SECTION("default") { }
+    SECTION("split dwarf")
+    {
+        scn.config = {{"debug", ""}, {"split_dwarf", "true"}};
+        exp.dwo = true;
+    }
+    SECTION("split dwarf without debug symbols")
+    {
+        scn.config = {{"split_dwarf", "true"}};
+    }
+    SECTION("gcc profile-guided optimization")
+    {
+        scn.config = {{"pgo", "use"}, {"pgo.dir", (dir / "pgo").string()}};
+        scn.create_profiles = true;
+    }
+    SECTION("clang profile-guided optimization")
+    {
+        scn.variant = GCCVariant::Clang;
+        scn.config = {{"pgo", "use"}, {"pgo.dir", (dir / "pgo").string()}};
+        scn.create_profiles = true;
+    }
+
+    {
+        test::GCCToolchain toolchain(context.toolchain(), scn.variant);
+        REQUIRE(toolchain.initialize(scn.config));
+    }
+
+    //Processes a recipe with two sources, as a new run of cook would, and returns the compile commands per object
+    auto run = [&]()
+    {
+        std::map<std::string, Step> steps;
+
+        model::Library lib;
+        model::Recipe * recipe = nullptr;
+        REQUIRE(lib.goc_recipe(recipe, model::Uri("/lib")));
+        for (const auto & source: {"a.cpp", "b.cpp"})
+        {
+            ingredient::File file(dir / "src", source);
+            file.set_owner(recipe);
+            REQUIRE(recipe->insert(LanguageTypePair(Language::CXX, Type::Source), file));
+        }
+
+        process::RecipeFilteredGraph g(std::make_shared<Graph>());
+        REQUIRE(process::souschef::Compiler(Language::CXX).process(*recipe, g, context));
+
+        for (auto vertex: g.command_vertices())
+        {
+            Step step;
+            std::string object;
+            g.input([&](auto v){ step.source = std::get<Graph::FileLabel>(g[v]).filename().string(); }, vertex, Graph::Explicit);
+            g.input([&](auto v){ step.implicit_inputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Implicit);
+            g.output([&](auto v){ object = std::get<Graph::FileLabel>(g[v]).string(); }, vertex, Graph::Explicit);
+            g.output([&](auto v){ step.implicit_outputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Implicit);
+            steps[object] = step;
+        }
+        REQUIRE(steps.size() == 2);
+        return steps;
+    };
+
+    const auto steps = run();
+    for (const auto & p: steps)
+    {
+        const auto & object = p.first;
+        const auto & step = p.second;
+        INFO(object);
+        REQUIRE((step.source == "a.cpp" || step.source == "b.cpp"));
+
+        const std::set<std::string> dwo = {std::filesystem::path(object).replace_extension(".dwo").string()};
+        if (exp.dwo)
+            REQUIRE(step.implicit_outputs == dwo);
+        else
+            REQUIRE(step.implicit_outputs.empty());
+
+        //Without profiles, no object depends on them
+        REQUIRE(step.implicit_inputs.empty());
+    }
+
+    if (scn.create_profiles)
+    {
+        if (scn.variant == GCCVariant::Genuine)
+        {
+            //Only the objects that were run during the training have a profile
+            std::string profile_a;
+            for (const auto & p: steps)
+                if (p.second.source == "a.cpp")
+                    profile_a = (dir / "pgo" / std::filesystem::path(p.first).replace_extension(".gcda").relative_path()).string();
+            std::filesystem::create_directories(std::filesystem::path(profile_a).parent_path());
+            std::ofstream(profile_a) << "profile";
+
+            for (const auto & p: run())
+            {
+                INFO(p.first);
+                if (p.second.source == "a.cpp")
+                    REQUIRE(p.second.implicit_inputs == std::set<std::string>{profile_a});
+                else
+                    REQUIRE(p.second.implicit_inputs.empty());
+            }
+        }
+        else
+        {
+            //All objects share the merged profile
+            const std::string profile = (dir / "pgo" / "default.profdata").string();
+            std::ofstream(profile) << "profile";
+
+            for (const auto & p: run())
+            {
+                INFO(p.first);
+                REQUIRE(p.second.implicit_inputs == std::set<std::string>{profile});
+            }
+        }
+    }
+
+}
+
+TEST_CASE("Compiler module scan tests", "[ut][souschef][compiler][modules]")
+{
+    using namespace cook;
+    using Graph = process::build::Graph;
+    using GCCVariant = test::GCCToolchain::GCCVariant;
+
+    test::TemporaryDir tmp("cook_compiler_scan_tests");
+    const std::filesystem::path & dir = tmp.path;
+
+    test::Context context(dir);
+
+    struct Scn
+    {
+        GCCVariant variant = GCCVariant::Genuine;
+    };
+    struct Exp
+    {
+        //The scanner of gcc also writes the preprocessed source
+        bool preprocessed = false;
+    };
+
+    Scn scn;
+    Exp exp;
+
+    SECTION("gcc")
+    {
+        exp.preprocessed = true;
+    }
+    SECTION("clang")
+    {
+        scn.variant = GCCVariant::Clang;
+    }
+
+    {
+        test::GCCToolchain toolchain(context.toolchain(), scn.variant);
+        test::GCCToolchain::set_plain_translators(*toolchain.scan);
+        toolchain.scan->translator_map()[process::toolchain::Part::Output] = [](const std::string & k, const std::string & v) { return "-o " + v + " > " + k; };
+        REQUIRE(toolchain.initialize({{"c++.modules", "true"}}));
+    }
+
+    model::Library lib;
+    model::Recipe * recipe = nullptr;
+    REQUIRE(lib.goc_recipe(recipe, model::Uri("/lib")));
+    {
+        ingredient::File file(dir / "src", "a.cpp");
+        file.set_owner(recipe);
+        REQUIRE(recipe->insert(LanguageTypePair(Language::CXX, Type::Source), file));
+    }
+
+    process::RecipeFilteredGraph g(std::make_shared<Graph>());
+    REQUIRE(process::souschef::Compiler(Language::CXX).process(*recipe, g, context));
+
+    unsigned int count = 0;
+    for (auto vertex: g.command_vertices())
+    {
+        auto ptr = std::get<Graph::CommandLabel>(g[vertex]);
+        if (ptr->name() != "Scan")
+            continue;
+        ++count;
+
+        process::command::Filenames inputs, outputs;
+        std::set<std::string> implicit_outputs;
+        g.input([&](auto v){ inputs.push_back(std::get<Graph::FileLabel>(g[v])); }, vertex, Graph::Explicit);
+        g.output([&](auto v){ outputs.push_back(std::get<Graph::FileLabel>(g[v])); }, vertex, Graph::Explicit);
+        g.output([&](auto v){ implicit_outputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Implicit);
+        REQUIRE(outputs.size() == 1);
+        const std::string ddi = outputs.front().string();
+        REQUIRE(std::filesystem::path(ddi).extension() == ".ddi");
+
+        if (exp.preprocessed)
+            REQUIRE(implicit_outputs == std::set<std::string>{ddi + ".i"});
+        else
+            REQUIRE(implicit_outputs.empty());
+
+        //The primary output of the scanned rule is the object
+        auto scan = std::dynamic_pointer_cast<process::command::Scan>(ptr);
+        REQUIRE(!!scan);
+        scan->set_inputs_outputs(inputs, outputs);
+        std::ostringstream oss;
+        scan->stream_command(oss);
+        const std::string object = std::filesystem::path(ddi).replace_extension().string();
+        INFO(oss.str());
+        REQUIRE(oss.str().find("-o " + object + " > " + ddi) != std::string::npos);
+    }
+    REQUIRE(count == 1);
+}
@@ -0,0 +1,188 @@
+#include "catch.hpp"
+#include "cook/process/souschef/Linker.hpp"
+#include "cook/test/Fixture.hpp"
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace  {
+
+//A command of the graph, as seen by a generator
+struct Step
+{
+    std::string name;
+    std::set<std::string> inputs;
+    std::set<std::string> implicit_inputs;
+    std::set<std::string> outputs;
+    std::string command;
+};
+
+}
+
+TEST_CASE("Linker tests", "[ut][souschef][linker]")
+{
+    using namespace cook;
+    using Graph = process::build::Graph;
+
+    test::TemporaryDir tmp("cook_linker_tests");
+    const std::filesystem::path & dir = tmp.path;
+    const std::filesystem::path profile_fn = dir / "app.fdata";
+    std::ofstream(profile_fn) << "profile";
+
+    test::Context context(dir);
+
+    struct Scn
+    {
+        //The global configuration and the toolchain options of the executable
+        test::GCCToolchain::Options config;
+        test::GCCToolchain::Options options;
+        std::filesystem::path working_directory;
+    };
+    struct Exp
+    {
+        bool ok = true;
+        //The steps by the name of their first explicit output
+        std::map<std::string, Step> steps;
+    };
+
+    Scn scn;
+    Exp exp;
+
+    const std::string app = (dir / "output" / "app").string();
+    const std::string obj = (dir / "objects" / "main.o").string();
+    const std::string profile = profile_fn.string();
+
+    SECTION("default")
+    {
+        exp.steps[app] = Step{"Link", {obj}, {}, {app}};
+    }
+    SECTION("unknown post-link optimization")
+    {
+        scn.options = {{"post_link", "unknown"}};
+        exp.ok = false;
+    }
+    SECTION("post-link optimization without a profile")
+    {
+        scn.options = {{"post_link", "bolt"}};
+        exp.ok = false;
+    }
+    SECTION("post-link optimization with a missing profile")
+    {
+        scn.options = {{"post_link", "bolt"}, {"post_link.profile", (dir / "missing.fdata").string()}};
+        exp.ok = false;
+    }
+    SECTION("bolt")
+    {
+        scn.options = {{"post_link", "bolt"}, {"post_link.profile", profile}, {"post_link.bolt", "llvm-bolt-17"}};
+        const std::string prebolt = app + ".prebolt";
+        exp.steps[prebolt] = Step{"Link", {obj}, {}, {prebolt}};
+        exp.steps[app] = Step{"PostLink", {prebolt}, {profile}, {app},
+            "llvm-bolt-17 -o " + app + " " + prebolt + " -reorder-blocks=ext-tsp -reorder-functions=cdsort -split-functions -split-all-cold -icf=1 -data=" + profile + " "};
+    }
+    SECTION("symbol order")
+    {
+        scn.options = {{"post_link", "symbol_order"}, {"post_link.profile", profile}};
+        const std::string prelink = app + ".prelink";
+        const std::string order = app + ".order";
+        exp.steps[prelink] = Step{"Link", {obj}, {}, {prelink}};
+        exp.steps[order] = Step{"PostLink", {prelink}, {profile}, {order, order + ".bolt"},
+            "llvm-bolt -generate-function-order=" + order + " " + prelink + " -reorder-functions=cdsort -data=" + profile + " -o " + order + ".bolt "};
+        exp.steps[app] = Step{"Link", {obj}, {order}, {app}};
+    }
+
+    SECTION("the global configuration does not opt in")
+    {
+        scn.config = {{"post_link", "bolt"}, {"post_link.profile", profile}};
+        exp.steps[app] = Step{"Link", {obj}, {}, {app}};
+    }
+    SECTION("a relative profile is found from the recipe")
+    {
+        scn.working_directory = dir;
+        scn.options = {{"post_link", "bolt"}, {"post_link.profile", "app.fdata"}};
+        scn.config = {{"post_link.bolt", "llvm-bolt-18"}};
+        const std::string prebolt = app + ".prebolt";
+        exp.steps[prebolt] = Step{"Link", {obj}, {}, {prebolt}};
+        exp.steps[app] = Step{"PostLink", {prebolt}, {profile}, {app},
+            "llvm-bolt-18 -o " + app + " " + prebolt + " -reorder-blocks=ext-tsp -reorder-functions=cdsort -split-functions -split-all-cold -icf=1 -data=" + profile + " "};
+    }
+
+    {
+        test::GCCToolchain toolchain(context.toolchain());
+        test::GCCToolchain::set_plain_translators(*toolchain.link);
+        REQUIRE(toolchain.initialize(scn.config));
+    }
+
+    model::Library lib;
+    model::Recipe * recipe = nullptr;
+    REQUIRE(lib.goc_recipe(recipe, model::Uri("/app")));
+    recipe->build_target().type = TargetType::Executable;
+    recipe->build_target().filename = "app";
+    recipe->set_working_directory(scn.working_directory);
+    for (const auto & p: scn.options)
+    {
+        ingredient::KeyValue option(p.first, p.second);
+        option.set_owner(recipe);
+        REQUIRE(recipe->insert(LanguageTypePair(Language::Undefined, Type::ToolchainOption), option));
+    }
+    {
+        ingredient::File file(dir / "objects", "main.o");
+        file.set_owner(recipe);
+        REQUIRE(recipe->insert(LanguageTypePair(Language::Binary, Type::Object), file));
+    }
+
+    process::RecipeFilteredGraph g(std::make_shared<Graph>());
+    const bool ok = process::souschef::Linker().process(*recipe, g, context);
+    REQUIRE(ok == exp.ok);
+
+    if (ok)
+    {
+        std::map<std::string, Step> steps;
+        for (auto vertex: g.command_vertices())
+        {
+            Step step;
+            auto ptr = std::get<Graph::CommandLabel>(g[vertex]);
+            step.name = ptr->name();
+
+            process::command::Filenames inputs, outputs;
+            g.input([&](auto v){ inputs.push_back(std::get<Graph::FileLabel>(g[v])); step.inputs.insert(inputs.back().string()); }, vertex, Graph::Explicit);
+            g.input([&](auto v){ step.implicit_inputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex, Graph::Implicit);
+            g.output([&](auto v){ step.outputs.insert(std::get<Graph::FileLabel>(g[v]).string()); }, vertex);
+            g.output([&](auto v){ outputs.push_back(std::get<Graph::FileLabel>(g[v])); }, vertex, Graph::Explicit);
+            REQUIRE(outputs.size() == 1);
+
+            if (step.name == "PostLink")
+            {
+                ptr->set_inputs_outputs(inputs, outputs);
+                std::ostringstream oss;
+                ptr->stream_command(oss);
+                step.command = oss.str();
+            }
+            else if (!step.implicit_inputs.empty())
+            {
+                //The ordered relink passes the symbol ordering file to the linker
+                ptr->set_inputs_outputs(inputs, outputs);
+                std::ostringstream oss;
+                ptr->stream_command(oss);
+                REQUIRE(oss.str().find("-Wl,--symbol-ordering-file=" + (app + ".order")) != std::string::npos);
+            }
+
+            steps[outputs.front().string()] = step;
+        }
+
+        REQUIRE(steps.size() == exp.steps.size());
+        for (const auto & p: exp.steps)
+        {
+            INFO(p.first);
+            REQUIRE(steps.count(p.first) == 1);
+            const auto & step = steps[p.first];
+            const auto & exp_step = p.second;
+            REQUIRE(step.name == exp_step.name);
+            REQUIRE(step.inputs == exp_step.inputs);
+            REQUIRE(step.implicit_inputs == exp_step.implicit_inputs);
+            REQUIRE(step.outputs == exp_step.outputs);
+            if (!exp_step.command.empty())
+                REQUIRE(step.command == exp_step.command);
+        }
+    }
+
+}
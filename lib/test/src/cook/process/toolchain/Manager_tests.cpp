@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "cook/process/toolchain/Manager.hpp"
+#include "cook/process/toolchain/native/Standard.hpp"
+#include "cook/process/toolchain/native/GCC.hpp"
+#include "cook/process/command/Compile.hpp"
+#include "cook/process/souschef/DependencyPropagator.hpp"
+#include "cook/model/Library.hpp"
+#include "cook/test/Fixture.hpp"
+#include <sstream>
+
+using namespace cook::process::toolchain;
+using cook::Language;
+using cook::TargetType;
+using cook::LanguageTypePair;
+
+namespace  {
+
+cook::model::Recipe * goc(cook::model::Library & lib, const std::string & str)
+{
+    cook::model::Recipe * ptr = nullptr;
+    REQUIRE(lib.goc_recipe(ptr, cook::model::Uri(str)));
+    return ptr;
+}
+
+void add_option(cook::model::Recipe & recipe, const std::string & key, const std::string & value, cook::Propagation propagation = cook::Propagation::Private)
+{
+    cook::ingredient::KeyValue kv(key, value);
+    kv.set_owner(&recipe);
+    kv.set_propagation(propagation);
+    kv.set_overwrite(cook::Overwrite::Always);
+    REQUIRE(recipe.insert(LanguageTypePair(Language::Undefined, cook::Type::ToolchainOption), kv));
+}
+
+}
+
+TEST_CASE("Toolchain manager tests", "[ut][toolchain][manager]")
+{
+    Manager manager;
+    auto cxx = manager.goc_element(Element::Compile, Language::CXX, TargetType::Object);
+    for (auto part: {Part::Cli, Part::Pre, Part::Define})
+        cxx->translator_map()[part] = [](const std::string & k, const std::string & v) { return v.empty() ? k : k + "=" + v; };
+    native::standard_config(manager);
+    native::gcc_config(manager, serialize::GCCVariant::Genuine);
+    manager.add_config("release");
+    REQUIRE(manager.initialize());
+
+    cook::model::Library lib;
+    auto pre = [&](cook::model::Recipe * recipe)
+    {
+        auto cmd = manager.create_command<cook::process::command::Compile>(Element::Compile, Language::CXX, TargetType::Object, recipe);
+        REQUIRE(!!cmd);
+        std::ostringstream oss;
+        cmd->stream_part(oss, Part::Pre);
+        return oss.str();
+    };
+
+    SECTION("without overrides, the global configuration is used")
+    {
+        REQUIRE(pre(goc(lib, "/cold")) == "-O3");
+    }
+    SECTION("the overrides of a recipe replace the global values")
+    {
+        auto hot = goc(lib, "/hot");
+        add_option(*hot, "optimization", "max_size");
+        add_option(*hot, "march", "x86-64-v3");
+        REQUIRE(pre(hot) == "-march=x86-64-v3 -Os");
+        REQUIRE(Manager::overrides(*hot).size() == 2);
+
+        REQUIRE(pre(goc(lib, "/cold")) == "-O3");
+        REQUIRE(manager.has_config("optimization", "max_speed"));
+        REQUIRE(!manager.has_config("optimization", "max_size"));
+    }
+    SECTION("the overrides of a recipe take precedence over the ones of its dependencies")
+    {
+        auto dep = goc(lib, "/dep");
+        add_option(*dep, "optimization", "max_speed", cook::Propagation::Public);
+        add_option(*dep, "march", "x86-64-v2", cook::Propagation::Public);
+        auto hot = goc(lib, "/hot");
+        add_option(*hot, "optimization", "max_size");
+        REQUIRE(hot->add_dependency(dep->uri()));
+        REQUIRE(hot->resolve_dependency(dep->uri(), dep));
+
+        cook::test::Context context(std::filesystem::temp_directory_path());
+        cook::process::RecipeFilteredGraph g(std::make_shared<cook::process::build::Graph>());
+        REQUIRE(cook::process::souschef::DependentPropagator().process(*hot, g, context));
+
+        REQUIRE(Manager::overrides(*hot) == Manager::Overrides{{"march", "x86-64-v2"}, {"optimization", "max_size"}});
+        REQUIRE(pre(hot) == "-march=x86-64-v2 -Os");
+    }
+    SECTION("a named configuration applies to all commands, the overrides of a recipe come on top")
+    {
+        REQUIRE(manager.set_configuration({{"optimization", "max_size"}}));
+        REQUIRE(pre(goc(lib, "/cold")) == "-Os");
+        REQUIRE(manager.has_config("optimization", "max_size"));
+
+        auto hot = goc(lib, "/hot");
+        add_option(*hot, "march", "x86-64-v3");
+        REQUIRE(pre(hot) == "-march=x86-64-v3 -Os");
+
+        REQUIRE(manager.set_configuration({}));
+        REQUIRE(pre(goc(lib, "/cold")) == "-O3");
+    }
+}
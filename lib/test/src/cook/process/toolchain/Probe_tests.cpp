@@ -0,0 +1,110 @@
+#include "catch.hpp"
+#include "cook/process/toolchain/Probe.hpp"
+#include "cook/test/Fixture.hpp"
+#include <fstream>
+
+using Probe = cook::process::toolchain::Probe;
+
+TEST_CASE("Toolchain probe tests", "[ut][toolchain][probe]")
+{
+    cook::test::TemporaryDir tmp("cook_probe_tests");
+    const std::filesystem::path & dir = tmp.path;
+
+    const std::filesystem::path compiler = dir / "fake-gcc";
+    std::ofstream(compiler) << "not really a compiler";
+
+    std::list<std::string> commands;
+    auto runner = [&](const std::string & command, std::string & output)
+    {
+        commands.push_back(command);
+        if (command.find("--version") != std::string::npos)
+            output = "fake-gcc (cook) 12.2.0\nCopyright\n";
+        else if (command.find("-dumpmachine") != std::string::npos)
+            output = "x86_64-linux-gnu\n";
+        return command.find("-fuse-ld=mold") == std::string::npos;
+    };
+
+    {
+        Probe probe(compiler.string(), dir / "cache");
+        probe.set_runner(runner);
+        REQUIRE(probe.compiler() == compiler);
+        REQUIRE(probe.version() == "fake-gcc (cook) 12.2.0");
+        REQUIRE(probe.target() == "x86_64-linux-gnu");
+        REQUIRE(probe.has_flag("-gsplit-dwarf"));
+        REQUIRE(!probe.has_linker("mold"));
+        REQUIRE(probe.has_linker("lld"));
+        REQUIRE(probe.version() == "fake-gcc (cook) 12.2.0");
+        REQUIRE(probe.nr_runs() == 5);
+    }
+
+    //The source the flags were tried with
+    std::string source_fn;
+    for (const auto & command: commands)
+        if (command.find("-gsplit-dwarf") != std::string::npos)
+        {
+            const auto e = command.find(".c\"");
+            source_fn = command.substr(0, e+2);
+            source_fn = source_fn.substr(source_fn.rfind('"')+1);
+        }
+    REQUIRE(std::filesystem::path(source_fn).parent_path() == dir / "cache");
+
+    SECTION("a warm run does not start the compiler")
+    {
+        Probe probe(compiler.string(), dir / "cache");
+        probe.set_runner(runner);
+        REQUIRE(probe.version() == "fake-gcc (cook) 12.2.0");
+        REQUIRE(probe.has_flag("-gsplit-dwarf"));
+        REQUIRE(!probe.has_linker("mold"));
+        REQUIRE(probe.nr_runs() == 0);
+    }
+    SECTION("a modified compiler is probed again")
+    {
+        std::ofstream(compiler) << "a different compiler";
+        Probe probe(compiler.string(), dir / "cache");
+        probe.set_runner(runner);
+        REQUIRE(probe.target() == "x86_64-linux-gnu");
+        REQUIRE(probe.nr_runs() == 1);
+    }
+    SECTION("compilers sharing the cache directory use their own probe files")
+    {
+        const std::filesystem::path other = dir / "fake-clang";
+        std::ofstream(other) << "another compiler";
+        commands.clear();
+        Probe probe(other.string(), dir / "cache");
+        probe.set_runner(runner);
+        REQUIRE(probe.has_flag("-gsplit-dwarf"));
+        REQUIRE(commands.size() == 1);
+        REQUIRE(commands.front().find(source_fn) == std::string::npos);
+        REQUIRE(commands.front().find("probe.exe") == std::string::npos);
+    }
+    SECTION("a failed probe is not cached")
+    {
+        //The source cannot be written when a directory takes its place
+        std::filesystem::remove(source_fn);
+        std::filesystem::create_directories(source_fn);
+        {
+            Probe probe(compiler.string(), dir / "cache");
+            probe.set_runner(runner);
+            REQUIRE(!probe.has_flag("-O2"));
+            REQUIRE(probe.nr_runs() == 0);
+            REQUIRE(probe.has_flag("-gsplit-dwarf"));
+        }
+        std::filesystem::remove(source_fn);
+        {
+            Probe probe(compiler.string(), dir / "cache");
+            probe.set_runner(runner);
+            REQUIRE(probe.has_flag("-O2"));
+            REQUIRE(probe.nr_runs() == 1);
+        }
+    }
+    SECTION("an unknown compiler is not run")
+    {
+        Probe probe("cook-does-not-exist-gcc", dir / "cache");
+        probe.set_runner(runner);
+        REQUIRE(probe.compiler().empty());
+        REQUIRE(probe.version().empty());
+        REQUIRE(!probe.has_flag("-g"));
+        REQUIRE(probe.nr_runs() == 0);
+    }
+
+}
@@ -0,0 +1,163 @@
+#include "catch.hpp"
+#include "cook/process/toolchain/Table.hpp"
+#include "cook/test/Fixture.hpp"
+#include <algorithm>
+
+using namespace cook::process::toolchain;
+using cook::Language;
+using cook::TargetType;
+
+namespace  {
+
+bool contains(const KeyValues & kvs, const std::string & key, const std::string & value = std::string())
+{
+    return std::find(kvs.begin(), kvs.end(), KeyValue(key, value)) != kvs.end();
+}
+
+}
+
+TEST_CASE("Toolchain configuration table tests", "[ut][toolchain][table]")
+{
+    SECTION("the first matching rule is applied")
+    {
+        Table table;
+        table.add("c++.std", {Element::Compile}, "", append(Part::Pre, "-std"));
+        table.add("config", {Element::Compile}, "release", append(Part::Pre, "-O3"));
+        table.add("config", {Element::Compile, Element::Link}, "", nothing());
+        REQUIRE(table.size() == 3);
+
+        ConfigurationBoard board;
+        Element compile(Element::Compile, Language::CXX, TargetType::Object);
+        Element link(Element::Link, Language::Binary, TargetType::Executable);
+        REQUIRE(table.process(compile, "config", "release", board));
+        REQUIRE(table.process(link, "config", "release", board));
+        REQUIRE(!table.process(link, "c++.std", "17", board));
+        REQUIRE(!table.process(compile, "optimization", "max_speed", board));
+        REQUIRE(compile.key_values_map()[Part::Pre] == KeyValues{KeyValue("-O3", "")});
+        REQUIRE(link.key_values_map()[Part::Pre].empty());
+    }
+    SECTION("native gcc configuration")
+    {
+        Manager manager;
+        cook::test::GCCToolchain tc(manager);
+
+        tc.manager.add_config("release");
+        tc.manager.add_config("c++.std", "17");
+        tc.manager.add_config("compiler", "g++-12");
+        REQUIRE(tc.manager.initialize());
+
+        REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-O3"));
+        REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-std", "c++17"));
+        REQUIRE(contains(tc.cxx->key_values_map()[Part::Define], "NDEBUG"));
+        REQUIRE(tc.cxx->key_values_map()[Part::Cli] == KeyValues{KeyValue("g++-12", "")});
+        REQUIRE(!contains(tc.c->key_values_map()[Part::Pre], "-std", "c++17"));
+        REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-std", "c++17"));
+        REQUIRE(!contains(tc.link->key_values_map()[Part::Pre], "-O3"));
+    }
+    SECTION("fast linking")
+    {
+        Manager manager;
+        cook::test::GCCToolchain tc(manager);
+
+        tc.manager.add_config("debug");
+        tc.manager.add_config("fast_link");
+        tc.manager.add_config("mold");
+        tc.manager.add_config("archive.update", "incremental");
+        REQUIRE(tc.manager.initialize());
+
+        REQUIRE(tc.manager.has_config("split_dwarf", "true"));
+        REQUIRE(tc.manager.has_config("debug_symbols", "true"));
+        REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-gsplit-dwarf"));
+        REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-fuse-ld=mold"));
+        REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-Wl,--gdb-index"));
+        const auto & ar_pre = tc.archive->key_values_map()[Part::Pre];
+        REQUIRE(ar_pre.size() == 1);
+        REQUIRE(ar_pre.front().first.find('T') != std::string::npos);
+        REQUIRE(ar_pre.front().first.find('u') != std::string::npos);
+        REQUIRE(ar_pre.front().first.find('U') != std::string::npos);
+    }
+    SECTION("profile-guided optimization")
+    {
+        using serialize::GCCVariant;
+        for (auto variant: {GCCVariant::Genuine, GCCVariant::Clang})
+        {
+            const bool genuine = (variant == GCCVariant::Genuine);
+            for (const std::string mode: {"generate", "use"})
+            {
+                Manager manager;
+                cook::test::GCCToolchain tc(manager, variant);
+
+                tc.manager.add_config("pgo", mode);
+                tc.manager.add_config("pgo.dir", "/pgo");
+                REQUIRE(tc.manager.initialize());
+
+                if (mode == "generate")
+                {
+                    REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-fprofile-generate=/pgo"));
+                    REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-fprofile-generate=/pgo"));
+                    REQUIRE(tc.manager.config_values("pgo.profile").empty());
+                }
+                else
+                {
+                    REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], genuine ? "-fprofile-use=/pgo" : "-fprofile-use=/pgo/default.profdata"));
+                    REQUIRE(tc.manager.config_values("pgo.profile") == std::list<std::string>{genuine ? "/pgo/{object}.gcda" : "/pgo/default.profdata"});
+                }
+            }
+        }
+    }
+    SECTION("post-link optimization")
+    {
+        Manager manager;
+        cook::test::GCCToolchain tc(manager, serialize::GCCVariant::Clang);
+
+        SECTION("symbol ordering")
+        {
+            tc.manager.add_config("post_link", "symbol_order");
+            tc.manager.add_config("post_link.profile", "perf.fdata");
+            REQUIRE(tc.manager.initialize());
+
+            REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-ffunction-sections"));
+            REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-fuse-ld=lld"));
+            REQUIRE(tc.manager.config_values("post_link.order_option") == std::list<std::string>{"-Wl,--symbol-ordering-file="});
+        }
+        SECTION("BOLT")
+        {
+            tc.manager.add_config("post_link", "bolt");
+            tc.manager.add_config("post_link.profile", "perf.fdata");
+            REQUIRE(tc.manager.initialize());
+
+            REQUIRE(!contains(tc.cxx->key_values_map()[Part::Pre], "-ffunction-sections"));
+            REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-Wl,--emit-relocs"));
+            REQUIRE(tc.manager.config_values("post_link.order_option").empty());
+        }
+    }
+    SECTION("link-time optimization")
+    {
+        using serialize::GCCVariant;
+        for (auto variant: {GCCVariant::Genuine, GCCVariant::Clang})
+        {
+            const bool genuine = (variant == GCCVariant::Genuine);
+            Manager manager;
+            cook::test::GCCToolchain tc(manager, variant);
+
+            tc.manager.add_config("lto", "thin");
+            tc.manager.add_config("lto.dir", "/lto");
+            tc.manager.add_config("lto.jobs", "4");
+            REQUIRE(tc.manager.initialize());
+
+            REQUIRE(contains(tc.archive->key_values_map()[Part::Cli], genuine ? "gcc-ar" : "llvm-ar"));
+            if (genuine)
+            {
+                REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-flto"));
+                REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-flto=4"));
+            }
+            else
+            {
+                REQUIRE(contains(tc.cxx->key_values_map()[Part::Pre], "-flto=thin"));
+                REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-Wl,--thinlto-cache-dir=/lto"));
+                REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-Wl,--thinlto-jobs=4"));
+                REQUIRE(contains(tc.link->key_values_map()[Part::Pre], "-fuse-ld=lld"));
+            }
+        }
+    }
+}
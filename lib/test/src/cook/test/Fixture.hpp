@@ -0,0 +1,95 @@
+#ifndef HEADER_cook_test_Fixture_hpp_ALREADY_INCLUDED
+#define HEADER_cook_test_Fixture_hpp_ALREADY_INCLUDED
+
+#include "cook/Context.hpp"
+#include "cook/process/toolchain/Manager.hpp"
+#include "cook/process/toolchain/native/Standard.hpp"
+#include "cook/process/toolchain/native/GCC.hpp"
+#include "gubg/std/filesystem.hpp"
+#include <list>
+#include <string>
+
+namespace cook { namespace test {
+
+    //A directory below the system temporary directory, empty at the start of a test and removed at the end
+    struct TemporaryDir
+    {
+        const std::filesystem::path path;
+
+        explicit TemporaryDir(const std::string & name)
+            : path(std::filesystem::weakly_canonical(std::filesystem::temp_directory_path()) / name)
+        {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+        }
+        ~TemporaryDir()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    };
+
+    struct Logger : cook::Logger
+    {
+        void log(const cook::Result &) const override {}
+    };
+
+    //Writes its output and temporary files below dir
+    struct Context : cook::Context
+    {
+        explicit Context(const std::filesystem::path & dir)
+        {
+            dirs().set_output(dir / "output");
+            dirs().set_temporary(dir / "temporary");
+        }
+
+        const cook::Logger & logger() const override { return logger_; }
+        cook::Result set_variable(const std::string &, const std::string &) override { return cook::Result(); }
+
+    private:
+        Logger logger_;
+    };
+
+    //The elements of a native gcc or clang toolchain, configured via the standard and gcc tables
+    struct GCCToolchain
+    {
+        using Element = process::toolchain::Element;
+        using GCCVariant = process::toolchain::serialize::GCCVariant;
+        //An option without value is set to true
+        using Options = std::list<std::pair<std::string, std::string>>;
+
+        process::toolchain::Manager & manager;
+        Element::Ptr cxx = manager.goc_element(Element::Compile, Language::CXX, TargetType::Object);
+        Element::Ptr c = manager.goc_element(Element::Compile, Language::C, TargetType::Object);
+        Element::Ptr scan = manager.goc_element(Element::Scan, Language::CXX, TargetType::Object);
+        Element::Ptr link = manager.goc_element(Element::Link, Language::Binary, TargetType::Executable);
+        Element::Ptr archive = manager.goc_element(Element::Archive, Language::Binary, TargetType::Archive);
+
+        explicit GCCToolchain(process::toolchain::Manager & manager, GCCVariant variant = GCCVariant::Genuine)
+            : manager(manager)
+        {
+            archive->key_values_map()[process::toolchain::Part::Pre].emplace_back("crs", "");
+            process::toolchain::native::standard_config(manager);
+            process::toolchain::native::gcc_config(manager, variant);
+        }
+
+        Result initialize(const Options & options = Options())
+        {
+            for (const auto & p: options)
+                if (p.second.empty())
+                    manager.add_config(p.first);
+                else
+                    manager.add_config(p.first, p.second);
+            return manager.initialize();
+        }
+
+        //The translators are set by the toolchain scripts, without them the key-values are streamed as-is
+        static void set_plain_translators(Element & element)
+        {
+            process::toolchain::each_part([&](auto part){ element.translator_map()[part] = [](const std::string & k, const std::string & v) { return k + v; }; });
+        }
+    };
+
+} }
+
+#endif
@@ -0,0 +1,80 @@
+#include "catch.hpp"
+#include "cook/util/HeaderMap.hpp"
+#include <cstdint>
+#include <cstring>
+
+using HeaderMap = cook::util::HeaderMap;
+
+namespace  {
+
+std::uint32_t read_u32(const std::string & data, std::size_t offset)
+{
+    std::uint32_t v;
+    std::memcpy(&v, data.data() + offset, sizeof(v));
+    return v;
+}
+
+//Performs the lookup the way clang does, on the serialized header map
+bool lookup_serialized(std::string & path, const std::string & data, const std::string & spelling)
+{
+    const std::uint32_t strings_offset = read_u32(data, 8);
+    const std::uint32_t num_buckets = read_u32(data, 16);
+    const auto string_at = [&](std::uint32_t offset) { return std::string(data.c_str() + strings_offset + offset); };
+
+    for (unsigned int i = 0, ix = HeaderMap::hash(spelling); i < num_buckets; ++i, ++ix)
+    {
+        const std::size_t bucket = 24 + (ix & (num_buckets-1))*12;
+        const std::uint32_t key = read_u32(data, bucket);
+        if (key == 0)
+            return false;
+        if (string_at(key) == spelling)
+        {
+            path = string_at(read_u32(data, bucket+4)) + string_at(read_u32(data, bucket+8));
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+TEST_CASE("Header map tests", "[ut][hmap]")
+{
+    HeaderMap hmap;
+    hmap.add("/a/src", "cook/Result.hpp");
+    hmap.add("/a/src", "cook/Type.hpp");
+    hmap.add("/b/inc", "gubg/mss.hpp");
+
+    SECTION("lookup")
+    {
+        std::filesystem::path path;
+        REQUIRE(hmap.size() == 3);
+        REQUIRE(hmap.lookup(path, "cook/Result.hpp"));
+        REQUIRE(path == std::filesystem::path("/a/src") / "cook/Result.hpp");
+        REQUIRE(!hmap.lookup(path, "cook/Other.hpp"));
+    }
+    SECTION("ambiguous spellings are left to the include paths")
+    {
+        hmap.add("/c/inc", "gubg/mss.hpp");
+        std::filesystem::path path;
+        REQUIRE(hmap.size() == 2);
+        REQUIRE(!hmap.lookup(path, "gubg/mss.hpp"));
+    }
+    SECTION("adding the same header twice is not ambiguous")
+    {
+        hmap.add("/b/inc", "gubg/mss.hpp");
+        REQUIRE(hmap.size() == 3);
+    }
+    SECTION("serialization")
+    {
+        const std::string data = hmap.serialize();
+        REQUIRE(read_u32(data, 0) == ((std::uint32_t('h') << 24) | ('m' << 16) | ('a' << 8) | 'p'));
+        REQUIRE(read_u32(data, 12) == 3);
+
+        std::string path;
+        REQUIRE(lookup_serialized(path, data, "cook/Type.hpp"));
+        REQUIRE(path == (std::filesystem::path("/a/src") / "cook/Type.hpp").string());
+        REQUIRE(lookup_serialized(path, data, "gubg/mss.hpp"));
+        REQUIRE(!lookup_serialized(path, data, "cook/Other.hpp"));
+    }
+}
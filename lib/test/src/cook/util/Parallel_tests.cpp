@@ -0,0 +1,21 @@
+#include "catch.hpp"
+#include "cook/util/Parallel.hpp"
+#include <atomic>
+#include <vector>
+
+TEST_CASE("parallel_for tests", "[ut][parallel]")
+{
+    SECTION("nothing to do")
+    {
+        bool called = false;
+        cook::util::parallel_for(0, [&](std::size_t) { called = true; });
+        REQUIRE(!called);
+    }
+    SECTION("each index is processed once")
+    {
+        std::vector<std::atomic<unsigned int>> counts(1000);
+        cook::util::parallel_for(counts.size(), [&](std::size_t ix) { ++counts[ix]; });
+        for (const auto & count: counts)
+            REQUIRE(count.load() == 1);
+    }
+}
@@ -212,6 +212,20 @@ namespace :b1 do
       publish($b1_cook)
     end
 
+    desc "bootstrap-level1: Build and run the benchmark on a synthetic recipe tree, eg rake b1:bench[books=100:recipes=50:fanout=5]"
+    task :bench, [:params] => "b0:build" do |t,args|
+        odir = File.join($b1_build_dir, "bench")
+        tdir = File.join($b1_tmp, "bench")
+
+        opts = toolchain_options.map {|k,v| ["-T"] + (v ? ["#{k}=#{v}"] : ["#{k}"]) }.flatten
+
+        Rake.sh($b0_cook, "-f", "./", "-g", "ninja", "-o", odir, "-O", tdir, *opts, "cook/lib/bench")
+        Rake.sh(ninja_exe, "-f", "#{odir}/build.ninja")
+        exe = "cook.lib.bench"
+        exe += ".exe" if GUBG::os == :windows
+        Rake.sh(File.join(odir, exe), *(args[:params] || "").split(":"))
+    end
+
     desc "bootstrap-level1-cmake: Build b1-cook.exe using b0-cook.exe"
     task :build_cmake => "b0:build" do
         cmake_dir = File.join($b1_tmp, "cmake")
@@ -20,3 +20,11 @@ test_case("script") do
     end
 end
 
+test_case("generated sources") do
+    cook_fn = File.expand_path("cook.exe")
+    Dir.chdir("scenario/script") do
+        sh("#{cook_fn} -f ./ -g ninja /script/app")
+        sh("ninja")
+        must(File.exist?("gen/version.cpp"))
+    end
+end
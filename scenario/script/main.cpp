@@ -0,0 +1,8 @@
+#include "version.hpp"
+#include <iostream>
+
+int main()
+{
+    std::cout << version() << std::endl;
+    return 0;
+}
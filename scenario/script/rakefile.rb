@@ -4,3 +4,9 @@ end
 task :ko do
     raise "KO"
 end
+task :generate do
+    version = File.read("version.txt").strip
+    mkdir_p "gen"
+    File.write("gen/version.hpp", "const char *version();\n")
+    File.write("gen/version.cpp", "#include \"version.hpp\"\nconst char *version() { return \"#{version}\"; }\n")
+end